@@ -2,21 +2,54 @@
 #define CDV_HPP
 
 #include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdio>
 #include <forward_list>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <list>
 #include <map>
 #include <memory>
+#include <numeric>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <variant>
 #include <vector>
 
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+#if __cplusplus >= 202002L || _MSVC_LANG >= 202002L
+#include <span>
+#endif
+
+// Vector instructions used by the numeric summaries of containers, see visualization::set_numeric_summary. Define
+// CDV_NO_SIMD to use the scalar code only.
+#if !defined(CDV_NO_SIMD) && defined(__AVX__)
+#include <immintrin.h>
+#define CDV_SIMD_AVX
+#elif !defined(CDV_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define CDV_SIMD_SSE2
+#endif
+
 namespace cdv
 {
 
@@ -420,6 +453,17 @@ void make_html_compatible(string_t &str)
     replace_all(str, string_t{lit(string_t, ">")}, string_t{lit(string_t, "&gt;")});
 }
 
+template <typename string_t>
+[[nodiscard]] string_t make_dot_quoted_string(string_t str)
+{
+    // Backslashes first, as escaping the quotes adds backslashes.
+    replace_all(str, string_t{lit(string_t, "\\")}, string_t{lit(string_t, "\\\\")});
+    replace_all(str, string_t{lit(string_t, "\"")}, string_t{lit(string_t, "\\\"")});
+    str.insert(0, lit(string_t, "\""));
+    str += lit(string_t, "\"");
+    return str;
+}
+
 template <typename string_t>
 void make_bold(string_t &str)
 {
@@ -473,11 +517,64 @@ string_t get_type_name_string()
     }
 }
 
+/**
+ * \return A type name from impl::get_type_name, ready to be written in an HTML label.
+ */
+template <typename string_t>
+string_t get_type_name_html(const std::string_view type_name)
+{
+    // Type names are made of ASCII characters.
+    auto result = string_t(type_name.begin(), type_name.end());
+    remove_class_struct(result);
+    make_html_compatible(result);
+    return result;
+}
+
+/**
+ * \return The text, with the addresses written by get_address_as_string that are in masked_addresses replaced by '@'.
+ */
+template <typename string_t>
+string_t mask_addresses(const string_t &text, const std::unordered_set<uint64_t> &masked_addresses)
+{
+    const auto get_digit_value = [](const typename string_t::value_type character) {
+        if (character >= '0' && character <= '9')
+        {
+            return character - '0';
+        }
+        return character >= 'a' && character <= 'f' ? character - 'a' + 10 : -1;
+    };
+
+    string_t result;
+    result.reserve(text.size());
+    size_t copied_end = 0;
+    for (size_t prefix = text.find(lit(string_t, "0x")); prefix != string_t::npos;
+         prefix = text.find(lit(string_t, "0x"), prefix + 2))
+    {
+        uint64_t address = 0;
+        size_t end = prefix + 2;
+        for (int digit_value = 0; end < text.size() && (digit_value = get_digit_value(text[end])) >= 0; ++end)
+        {
+            address = (address << 4) | static_cast<uint64_t>(digit_value);
+        }
+        if (end > prefix + 2 && masked_addresses.count(address) != 0)
+        {
+            result.append(text, copied_end, prefix - copied_end);
+            result += lit(string_t, "@");
+            copied_end = end;
+        }
+    }
+    result.append(text, copied_end, string_t::npos);
+    return result;
+}
+
 // Some graphviz generation function templates must be forward-declared here.
 
 template <typename string_t>
 [[nodiscard]] string_t generate_table_node_cell_html(const typename table_node<string_t>::cell &cell);
 
+template <typename string_t>
+[[nodiscard]] string_t generate_table_node_cell_opening_html(const typename table_node<string_t>::cell &cell);
+
 template <typename string_t>
 [[nodiscard]] string_t generate_node_appearance_string(const node_appearance<string_t> &appearance,
                                                        const node_appearance<string_t> &default_node_appearance);
@@ -530,6 +627,112 @@ struct node_appearance
 
 // ------------------------------------------------ base_node------------------------------------------------ //
 
+/**
+ * Position of a member of an adapted class inside its object, see class_layout.
+ */
+struct member_layout
+{
+    std::string name;
+    size_t offset{0};
+    size_t size{0};
+};
+
+/**
+ * Byte range of an object that is not covered by any of its located members, see class_layout::get_holes.
+ */
+struct layout_hole
+{
+    size_t offset{0};
+    size_t size{0};
+};
+
+/**
+ * Layout of the objects of an adapted class: where each declared member is stored, and which bytes are left unused.
+ * Measured once per class, on the first instance traversed (see visualization::get_class_layouts).
+ */
+struct class_layout
+{
+    static constexpr size_t cache_line_bytes = 64;
+
+    // C++ name of the class, pointing to static storage (see impl::get_type_name).
+    std::string_view type_name{};
+    // sizeof and alignof the class.
+    size_t size{0};
+    size_t alignment{0};
+    // Members stored inside the object, by increasing offset.
+    std::vector<member_layout> members{};
+    // Members whose getter returns a value rather than a reference to the object's storage, or that were not displayed
+    // for the measured instance: their position is unknown.
+    std::vector<std::string> unlocated_member_names{};
+
+    /**
+     * \return The byte ranges not covered by any located member, by increasing offset. They are padding, unless some
+     * members are not declared to cdv or cannot be located: undeclared members, base classes and virtual table pointers
+     * also appear as holes.
+     */
+    [[nodiscard]] std::vector<layout_hole> get_holes() const
+    {
+        std::vector<layout_hole> holes;
+        size_t covered_end = 0;
+        for (const member_layout &member : members)
+        {
+            if (member.offset > covered_end)
+            {
+                holes.push_back({covered_end, member.offset - covered_end});
+            }
+            covered_end = std::max(covered_end, member.offset + member.size);
+        }
+        if (size > covered_end)
+        {
+            holes.push_back({covered_end, size - covered_end});
+        }
+        return holes;
+    }
+
+    /**
+     * \return The bytes of each object not covered by any located member (see get_holes).
+     */
+    [[nodiscard]] size_t get_hole_bytes() const
+    {
+        size_t hole_bytes = 0;
+        for (const layout_hole &hole : get_holes())
+        {
+            hole_bytes += hole.size;
+        }
+        return hole_bytes;
+    }
+};
+
+/**
+ * Memory used by the object represented by a node. Filled in by the automatic traversal of data structures, left empty
+ * for nodes added by hand.
+ */
+struct memory_footprint
+{
+    // C++ name of the type of the object, pointing to static storage (see impl::get_type_name).
+    std::string_view type_name{};
+    // sizeof the object.
+    size_t object_bytes{0};
+    // Heap memory owned by the object and by the values displayed inside its node: buffer of a vector, nodes of a
+    // list, buffer of a string not stored inline. Memory owned by values displayed in other nodes is not counted.
+    size_t heap_bytes{0};
+    // Layout of the object, for adapted classes only.
+    const class_layout *layout{nullptr};
+};
+
+/**
+ * Cell of a node drawn without Graphviz, see base_node::get_grid_rows.
+ */
+template <typename string_t>
+struct grid_cell
+{
+    // Content of the cell, as written in the HTML label of the node.
+    string_t html{};
+    string_t port_name{};
+    string_t background_color{};
+    int column_span{1};
+};
+
 template <typename string_t = std::string>
 class base_node
 {
@@ -544,8 +747,33 @@ class base_node
     [[nodiscard]] virtual string_t generate_structure_string(
         const node_appearance<string_t> &default_node_appearance) const = 0;
 
+    /**
+     * \return The cells of the node's table, row by row, for the exports drawing the nodes themselves (see
+     * generate_svg_visualization_string). Nodes that are not tables have no rows, and are drawn as empty boxes.
+     */
+    [[nodiscard]] virtual std::vector<std::vector<grid_cell<string_t>>> get_grid_rows() const
+    {
+        return {};
+    }
+
+    [[nodiscard]] const memory_footprint &get_memory_footprint() const
+    {
+        return m_memory_footprint;
+    }
+
+    void set_memory_footprint(const memory_footprint &footprint)
+    {
+        m_memory_footprint = footprint;
+    }
+
+    void add_owned_heap_bytes(const size_t heap_bytes)
+    {
+        m_memory_footprint.heap_bytes += heap_bytes;
+    }
+
   protected:
     node_appearance<string_t> m_appearance{};
+    memory_footprint m_memory_footprint{};
 };
 
 // ------------------------------------------------- table -------------------------------------------------- //
@@ -564,6 +792,7 @@ class table
 
         value_t value{};
         string_t port_name{};
+        string_t background_color{};
         int column_span{1};
         int row_span{1};
 
@@ -580,14 +809,6 @@ class table
             : value{std::move(_value)}
         {
         }
-        explicit cell(const table &_value)
-            : value{std::make_unique<table>(*_value)} // Copy the table to newly allocated memory.
-        {
-        }
-        explicit cell(table &&_value)
-            : value{std::make_unique<table>(std::move(_value))} // Move the table to newly allocated memory.
-        {
-        }
 
         /**
          *
@@ -628,6 +849,12 @@ class table
             return *this;
         }
 
+        cell &with_background_color(const string_t &_background_color)
+        {
+            background_color = _background_color;
+            return *this;
+        }
+
         cell &spanning_rows(const int _row_span)
         {
             row_span = _row_span;
@@ -644,6 +871,22 @@ class table
     struct row
     {
         std::vector<cell> cells{};
+        // Values of the cells written after the other cells, one after the other: value i ends at bulk_value_ends[i].
+        // Big containers of numbers are formatted in bulk (see impl::append_bulk_values), rather than through a cell
+        // and a string per value.
+        string_t bulk_values{};
+        std::vector<size_t> bulk_value_ends{};
+
+        [[nodiscard]] size_t get_cell_count() const
+        {
+            return cells.size() + bulk_value_ends.size();
+        }
+
+        [[nodiscard]] string_t get_bulk_value(const size_t index) const
+        {
+            const size_t first = index == 0 ? 0 : bulk_value_ends[index - 1];
+            return bulk_values.substr(first, bulk_value_ends[index] - first);
+        }
 
         template <typename T1, typename... Ts>
         void build(T1 &&cell_value)
@@ -657,6 +900,8 @@ class table
             {
                 // The value is a row cell. Move it into this.
                 cells = std::move(cell_value.cells);
+                bulk_values = std::move(cell_value.bulk_values);
+                bulk_value_ends = std::move(cell_value.bulk_value_ends);
             }
             else
             {
@@ -729,19 +974,12 @@ class table
             return {};
         }
 
-        string_t result;
-        result += lit(string_t, "<table border=\"");
-        result += cdv::to_string<string_t>(m_table_border);
-        result += lit(string_t, "\" cellborder=\"");
-        result += cdv::to_string<string_t>(m_cell_border);
-        result += lit(string_t, "\" cellspacing=\"");
-        result += cdv::to_string<string_t>(m_cell_spacing);
-        result += lit(string_t, "\">");
+        string_t result = generate_table_opening_html_string();
 
         const size_t cell_count_of_longest_row =
             std::max_element(m_rows.begin(), m_rows.end(), [](const row &row1, const row &row2) {
-                return row1.cells.size() < row2.cells.size();
-            })->cells.size();
+                return row1.get_cell_count() < row2.get_cell_count();
+            })->get_cell_count();
 
         // Each row.
         for (const row &current_row : m_rows)
@@ -755,6 +993,17 @@ class table
                 result += impl::generate_table_node_cell_html<string_t>(cell);
                 current_column_position += cell.column_span;
             }
+            // The values and their "<td >" and "</td>" tags.
+            result.reserve(result.size() + current_row.bulk_values.size() + 10 * current_row.bulk_value_ends.size());
+            size_t bulk_value_first = 0;
+            for (const size_t bulk_value_last : current_row.bulk_value_ends)
+            {
+                result += lit(string_t, "<td >");
+                result.append(current_row.bulk_values, bulk_value_first, bulk_value_last - bulk_value_first);
+                result += lit(string_t, "</td>");
+                bulk_value_first = bulk_value_last;
+            }
+            current_column_position += current_row.bulk_value_ends.size();
 
             // If this row has fewer cells than the longest row, add empty rows at the end.
             if (current_column_position < cell_count_of_longest_row)
@@ -775,6 +1024,19 @@ class table
         return result;
     }
 
+    [[nodiscard]] string_t generate_table_opening_html_string() const
+    {
+        string_t result;
+        result += lit(string_t, "<table border=\"");
+        result += cdv::to_string<string_t>(m_table_border);
+        result += lit(string_t, "\" cellborder=\"");
+        result += cdv::to_string<string_t>(m_cell_border);
+        result += lit(string_t, "\" cellspacing=\"");
+        result += cdv::to_string<string_t>(m_cell_spacing);
+        result += lit(string_t, "\">");
+        return result;
+    }
+
   protected:
     std::vector<row> m_rows{};
     int m_cell_border{1};
@@ -823,10 +1085,158 @@ class table_node : public table<string_t>, public base_node<string_t>
         //
         return result;
     }
+
+    [[nodiscard]] std::vector<std::vector<grid_cell<string_t>>> get_grid_rows() const override
+    {
+        std::vector<std::vector<grid_cell<string_t>>> grid_rows;
+        grid_rows.reserve(table<string_t>::m_rows.size());
+        for (const auto &row : table<string_t>::m_rows)
+        {
+            auto &grid_row = grid_rows.emplace_back();
+            grid_row.reserve(row.get_cell_count());
+            for (const auto &cell : row.cells)
+            {
+                grid_row.push_back({cell.value, cell.port_name, cell.background_color, cell.column_span});
+            }
+            for (size_t index = 0; index < row.bulk_value_ends.size(); ++index)
+            {
+                grid_row.push_back({row.get_bulk_value(index)});
+            }
+        }
+        return grid_rows;
+    }
+};
+
+// ------------------------------------------- adapted_class_node ------------------------------------------- //
+
+namespace impl
+{
+/**
+ * Pre-rendered HTML table of an adapted class, split around the parts that depend on the instance: its address and the
+ * values of its members. Everything else (type name, member names, ports, table layout) only depends on the class, and
+ * is rendered once per class (see get_adapted_class_skeleton).
+ */
+template <typename string_t>
+struct adapted_class_skeleton
+{
+    // Content of the cells that only depend on the class, for the exports drawing the nodes themselves.
+    string_t type_name{};
+    std::vector<string_t> member_names{};
+    // Opening of the table and of the header row, up to the content of the address cell.
+    string_t header_opening{};
+    // End of the address cell and of the header row.
+    string_t header_closing{};
+    // For each member index, opening of the member's row up to the content of the value cell.
+    std::vector<string_t> member_row_openings{};
+    // For each member index, the port of the member's value cell.
+    std::vector<string_t> port_names{};
+    // End of the value cell and of the member's row.
+    string_t member_row_closing{};
+    string_t table_closing{};
+};
+} // namespace impl
+
+/**
+ * Node of an instance of an adapted class. Only stores the strings that depend on the instance, which are spliced into
+ * the pre-rendered table of the class when generating the node.
+ */
+template <typename string_t = std::string>
+class adapted_class_node : public base_node<string_t>
+{
+  public:
+    adapted_class_node(const impl::adapted_class_skeleton<string_t> &skeleton, string_t instance_address)
+        : base_node<string_t>()
+        , m_skeleton{&skeleton}
+        , m_instance_address{std::move(instance_address)}
+    {
+        // Tables draw their border themselves, therefore use plaintext mode to avoid
+        // drawing it a second time.
+        base_node<string_t>::m_appearance.shape = node_shape::plaintext;
+    }
+
+    [[nodiscard]] const impl::adapted_class_skeleton<string_t> &get_skeleton() const
+    {
+        return *m_skeleton;
+    }
+
+    void add_member_value(const size_t member_index, string_t &&value)
+    {
+        m_member_values.emplace_back(member_index, std::move(value));
+    }
+
+    [[nodiscard]] string_t generate_structure_string(
+        const node_appearance<string_t> &default_node_appearance) const override
+    {
+        string_t result;
+        size_t result_length = m_skeleton->header_opening.size() + m_instance_address.size() +
+                               m_skeleton->header_closing.size() + m_skeleton->table_closing.size() + 32;
+        for (const auto &[member_index, value] : m_member_values)
+        {
+            result_length += m_skeleton->member_row_openings[member_index].size() + value.size() +
+                             m_skeleton->member_row_closing.size();
+        }
+        result.reserve(result_length);
+
+        // Start structure.
+        result += lit(string_t, "[");
+        result +=
+            impl::generate_node_appearance_string<string_t>(base_node<string_t>::m_appearance, default_node_appearance);
+
+        // Label, ie content of the table.
+        result += lit(string_t, "label=<\n\t");
+        result += m_skeleton->header_opening;
+        result += m_instance_address;
+        result += m_skeleton->header_closing;
+        for (const auto &[member_index, value] : m_member_values)
+        {
+            result += m_skeleton->member_row_openings[member_index];
+            result += value;
+            result += m_skeleton->member_row_closing;
+        }
+        result += m_skeleton->table_closing;
+        result += lit(string_t, ">]");
+        return result;
+    }
+
+    [[nodiscard]] std::vector<std::vector<grid_cell<string_t>>> get_grid_rows() const override
+    {
+        std::vector<std::vector<grid_cell<string_t>>> grid_rows;
+        grid_rows.reserve(m_member_values.size() + 1);
+        grid_rows.push_back({{m_skeleton->type_name}, {m_instance_address}});
+        for (const auto &[member_index, value] : m_member_values)
+        {
+            grid_rows.push_back({{m_skeleton->member_names[member_index]},
+                                 {value, m_skeleton->port_names[member_index]}});
+        }
+        return grid_rows;
+    }
+
+  private:
+    const impl::adapted_class_skeleton<string_t> *m_skeleton;
+    string_t m_instance_address;
+    // Member index, value.
+    std::vector<std::pair<size_t, string_t>> m_member_values{};
 };
 
 // ------------------------------------------------- arrow -------------------------------------------------- //
 
+/**
+ * How a pointer edge owns the object it points to. Composition edges always own the object they point to, which is
+ * stored inside the source object.
+ */
+enum class pointer_ownership
+{
+    // Raw pointers: the pointed object is owned elsewhere.
+    none,
+    // std::unique_ptr: the pointer is the only owner of the pointed object.
+    exclusive,
+    // std::shared_ptr: the pointer keeps the pointed object alive, along with the other pointers sharing its control
+    // block.
+    shared,
+    // std::weak_ptr: the pointer observes an object owned by shared pointers, without keeping it alive.
+    weak
+};
+
 template <typename string_t = std::string>
 struct arrow
 {
@@ -866,17 +1276,26 @@ struct arrow
         return *this;
     }
 
+    arrow &with_ownership(const pointer_ownership _ownership)
+    {
+        ownership = _ownership;
+        return *this;
+    }
+
     bool operator==(const arrow &rhs) const
     {
-        return shape == rhs.shape && style == rhs.style && source_node_id == rhs.source_node_id &&
-               destination_node_id == rhs.destination_node_id && source_port == rhs.source_port &&
-               destination_port == rhs.destination_port;
+        return shape == rhs.shape && style == rhs.style && ownership == rhs.ownership &&
+               source_node_id == rhs.source_node_id && destination_node_id == rhs.destination_node_id &&
+               source_port == rhs.source_port && destination_port == rhs.destination_port;
     }
 
     // Visual appearance information.
     arrow_shape shape{arrow_shape::normal};
     edge_style style{edge_style::normal};
 
+    // Ownership of the destination object, for pointer edges (see visualization::find_reference_cycles).
+    pointer_ownership ownership{pointer_ownership::none};
+
     // Actual edge data.
     uint64_t source_node_id;
     string_t source_port{};
@@ -895,6 +1314,21 @@ struct cluster
     node_appearance<string_t> default_node_appearance{};
 };
 
+// ---------------------------------------------- memory_arena ---------------------------------------------- //
+
+/**
+ * Address range registered with visualization::add_memory_arena: memory pool, block of an arena allocator, etc.
+ */
+template <typename string_t = std::string>
+struct memory_arena
+{
+    uint64_t begin_address{0};
+    uint64_t end_address{0};
+    string_t name{};
+    // Appearance of the cluster of the nodes of the arena, see memory_region_grouping::arena.
+    cluster<string_t> appearance{};
+};
+
 // --------------------------------------------- rank_constraint -------------------------------------------- //
 
 struct rank_constraint
@@ -913,6 +1347,19 @@ enum class member_display_type
      * TODO : currently unsupported, falls back on the 'composition_edge' behaviour.
      */
     inside,
+    /**
+     * Display a statistical summary of the values inside the node of their container, instead of the values
+     * themselves: min, max, mean, standard deviation, NaN and infinity counts, and a histogram.
+     * Replaces 'inside' for the containers of numbers longer than the threshold set with
+     * visualization::set_numeric_summary.
+     */
+    statistics,
+    /**
+     * Display the values of a container of rows of numbers as a matrix inside the node of the container, instead of
+     * one node per row: a grid of blocks of values, each colored by its value, downsampled to a bounded size.
+     * Replaces the nodes of the rows when enabled with visualization::set_matrix_display.
+     */
+    matrix,
     /**
      * Display the data as a separate node, the address of the data inside a cell of the containing instance's node, and
      * a POINTER edge going from the cell to the node.
@@ -949,6 +1396,32 @@ struct key_value_container : std::false_type
 template <typename container_t>
 constexpr bool is_key_value_container_v = key_value_container<container_t>::value;
 
+// ----------- view ----------
+
+// Non-owning views of values stored elsewhere (std::string_view, std::span, cdv::array_view). They are identified by
+// the values they view, their number and the type of the view, display the address of the viewed values rather than
+// their own, and do not count in the memory usage.
+template <typename view_t>
+struct view : std::false_type
+{
+};
+
+template <typename view_t>
+constexpr bool is_view_v = view<view_t>::value;
+
+// ----------- memory_resource ----------
+
+// Allocators whose memory resource (arena, pool, etc.) is shown in the node of the containers using them. To show the
+// arena of a custom allocator, specialize it with:
+//  static const void *get_memory_resource(const allocator_t &allocator);
+template <typename allocator_t>
+struct memory_resource : std::false_type
+{
+};
+
+template <typename allocator_t>
+constexpr bool has_memory_resource_v = memory_resource<allocator_t>::value;
+
 // ----------- custom user classes ----------
 
 template <typename adapted_class_t, size_t member_index>
@@ -959,31 +1432,178 @@ struct access : std::false_type
     // static bool display_member();
 };
 
-template <typename adapted_class_t>
-constexpr bool is_adapted_v =
-    access<adapted_class_t, 0>::value; // A class is adapted if it declares at least one member.
+/**
+ * Describes a public data member of an adapted class, with the same interface as access<>.
+ */
+template <typename class_t, typename member_t>
+struct member_descriptor
+{
+    const char *name;
+    member_t class_t::*pointer;
 
-// -------------- global checks -------------
+    [[nodiscard]] constexpr const char *get_member_name() const
+    {
+        return name;
+    }
+    [[nodiscard]] const member_t &get_member_value(const class_t &instance) const
+    {
+        return instance.*pointer;
+    }
+    [[nodiscard]] constexpr bool display_member(const class_t &) const
+    {
+        return true;
+    }
+};
 
-template <typename data_t>
-constexpr bool is_container_v = is_linear_container_v<data_t> || is_key_value_container_v<data_t>;
+template <typename class_t, typename member_t>
+constexpr member_descriptor<class_t, member_t> make_member_descriptor(const char *name, member_t class_t::*pointer)
+{
+    return {name, pointer};
+}
 
-template <typename data_t>
-constexpr bool is_handled_by_cdv_v = is_container_v<data_t> // TODO: find better name than "is_handled_by_cdv_v"
-                                     || is_adapted_v<data_t>;
+template <size_t member_index, typename member_descriptor_t>
+struct member_table_entry
+{
+    member_descriptor_t descriptor;
+};
 
-} // namespace traits
+template <typename member_indices_t, typename... member_descriptors_t>
+struct member_table_entries;
 
-// Todo: put this in a separate file under "cdv_std_tags.h"
-namespace traits
+template <size_t... member_indices, typename... member_descriptors_t>
+struct member_table_entries<std::index_sequence<member_indices...>, member_descriptors_t...>
+    : member_table_entry<member_indices, member_descriptors_t>...
 {
-// ------------------------------------------------------------------------------------------------------------- //
-//                   	DEFAULT IMPLEMENTATION OF REQUIRED TYPE TRAITS FOR STD CONTAINERS                   	//
-// ------------------------------------------------------------------------------------------------------------- //
+};
 
-// Contiguous storage array-like containers.
+/**
+ * Constexpr table of the member descriptors of an adapted class. Unlike std::tuple, entries are flat bases: reaching
+ * one does not instantiate a chain of helpers per member index, which matters when hundreds of classes are adapted.
+ */
+template <typename... member_descriptors_t>
+struct member_table : member_table_entries<std::index_sequence_for<member_descriptors_t...>, member_descriptors_t...>
+{
+    static constexpr size_t size = sizeof...(member_descriptors_t);
+};
+
+template <typename... member_descriptors_t>
+constexpr member_table<member_descriptors_t...> make_member_table(const member_descriptors_t &...descriptors)
+{
+    return {{{descriptors}...}};
+}
+
+/**
+ * Classes adapted all at once (see CDV_ADAPT_CLASS) declare the tuple of their member descriptors here.
+ */
+template <typename adapted_class_t>
+struct members : std::false_type
+{
+    // static constexpr auto get(); -> member_table<member_descriptor<adapted_class_t, ...>...>
+};
+
+template <typename adapted_class_t>
+constexpr bool is_adapted_v =
+    members<adapted_class_t>::value ||
+    access<adapted_class_t, 0>::value; // A class is adapted if it declares at least one member.
+
+// ----------- struct of arrays ----------
+
+/**
+ * Struct-of-arrays classes (see CDV_ADAPT_COLUMNS) declare the table of their column descriptors here. The columns are
+ * linear containers of the same length, displayed as one table with a row per index.
+ */
+template <typename columnar_class_t>
+struct columns : std::false_type
+{
+    // static constexpr auto get(); -> member_table<member_descriptor<columnar_class_t, ...>...>
+};
+
+template <typename columnar_class_t>
+constexpr bool is_columnar_v = columns<columnar_class_t>::value;
+
+// -------------- global checks -------------
+
+template <typename data_t>
+constexpr bool is_container_v = is_linear_container_v<data_t> || is_key_value_container_v<data_t>;
+
+template <typename data_t>
+constexpr bool is_handled_by_cdv_v = is_container_v<data_t> // TODO: find better name than "is_handled_by_cdv_v"
+                                     || is_adapted_v<data_t> || is_columnar_v<data_t>;
+
+} // namespace traits
+
+/**
+ * Non-owning view of contiguous values, such as a buffer passed around as a pointer and a length. Displayed like a
+ * container of these values, without copying them (see make_array_view).
+ */
+template <typename value_t>
+class array_view
+{
+  public:
+    using value_type = std::remove_cv_t<value_t>;
+    using const_iterator = const value_t *;
+
+    constexpr array_view(value_t *data, const size_t size)
+        : m_data{data}
+        , m_size{size}
+    {
+    }
+
+    [[nodiscard]] constexpr value_t *data() const
+    {
+        return m_data;
+    }
+    [[nodiscard]] constexpr size_t size() const
+    {
+        return m_size;
+    }
+    [[nodiscard]] constexpr bool empty() const
+    {
+        return m_size == 0;
+    }
+    [[nodiscard]] constexpr const_iterator begin() const
+    {
+        return m_data;
+    }
+    [[nodiscard]] constexpr const_iterator end() const
+    {
+        return m_data + m_size;
+    }
+    [[nodiscard]] constexpr const_iterator cbegin() const
+    {
+        return begin();
+    }
+    [[nodiscard]] constexpr const_iterator cend() const
+    {
+        return end();
+    }
+
+  private:
+    value_t *m_data;
+    size_t m_size;
+};
+
+/**
+ * \return A view of the size values starting at data, to pass to visualization::add_data_structure.
+ * \note Views of the same values share a single node. Views of different lengths have their own node, and so does the
+ * container whose values are viewed.
+ */
 template <typename value_t>
-struct linear_container<std::vector<value_t>> : std::true_type
+constexpr array_view<const value_t> make_array_view(const value_t *data, const size_t size)
+{
+    return {data, size};
+}
+
+// Todo: put this in a separate file under "cdv_std_tags.h"
+namespace traits
+{
+// ------------------------------------------------------------------------------------------------------------- //
+//                   	DEFAULT IMPLEMENTATION OF REQUIRED TYPE TRAITS FOR STD CONTAINERS                   	//
+// ------------------------------------------------------------------------------------------------------------- //
+
+// Contiguous storage array-like containers.
+template <typename value_t, typename allocator_t>
+struct linear_container<std::vector<value_t, allocator_t>> : std::true_type
 {
 };
 template <typename value_t, size_t len>
@@ -991,33 +1611,71 @@ struct linear_container<std::array<value_t, len>> : std::true_type
 {
 };
 
-// Linked-list containers.
+// Views of contiguous values.
 template <typename value_t>
-struct linear_container<std::list<value_t>> : std::true_type
+struct linear_container<array_view<value_t>> : std::true_type
 {
 };
 template <typename value_t>
-struct linear_container<std::forward_list<value_t>> : std::true_type
+struct view<array_view<value_t>> : std::true_type
+{
+};
+#ifdef __cpp_lib_span
+template <typename value_t, size_t extent>
+struct linear_container<std::span<value_t, extent>> : std::true_type
+{
+};
+template <typename value_t, size_t extent>
+struct view<std::span<value_t, extent>> : std::true_type
+{
+};
+#endif
+// String views are displayed as text, like strings.
+template <typename char_t, typename traits_t>
+struct view<std::basic_string_view<char_t, traits_t>> : std::true_type
+{
+};
+
+// Linked-list containers.
+template <typename value_t, typename allocator_t>
+struct linear_container<std::list<value_t, allocator_t>> : std::true_type
+{
+};
+template <typename value_t, typename allocator_t>
+struct linear_container<std::forward_list<value_t, allocator_t>> : std::true_type
 {
 };
 
 // Key-Value containers.
-template <typename key_t, typename value_t>
-struct key_value_container<std::map<key_t, value_t>> : std::true_type
+template <typename key_t, typename value_t, typename compare_t, typename allocator_t>
+struct key_value_container<std::map<key_t, value_t, compare_t, allocator_t>> : std::true_type
+{
+};
+template <typename key_t, typename value_t, typename compare_t, typename allocator_t>
+struct key_value_container<std::multimap<key_t, value_t, compare_t, allocator_t>> : std::true_type
 {
 };
-template <typename key_t, typename value_t>
-struct key_value_container<std::multimap<key_t, value_t>> : std::true_type
+template <typename key_t, typename value_t, typename hash_t, typename key_equal_t, typename allocator_t>
+struct key_value_container<std::unordered_map<key_t, value_t, hash_t, key_equal_t, allocator_t>> : std::true_type
 {
 };
-template <typename key_t, typename value_t>
-struct key_value_container<std::unordered_map<key_t, value_t>> : std::true_type
+template <typename key_t, typename value_t, typename hash_t, typename key_equal_t, typename allocator_t>
+struct key_value_container<std::unordered_multimap<key_t, value_t, hash_t, key_equal_t, allocator_t>>
+    : std::true_type
 {
 };
-template <typename key_t, typename value_t>
-struct key_value_container<std::unordered_multimap<key_t, value_t>> : std::true_type
+
+#ifdef __cpp_lib_memory_resource
+// Polymorphic allocators (std::pmr containers).
+template <typename value_t>
+struct memory_resource<std::pmr::polymorphic_allocator<value_t>> : std::true_type
 {
+    static const void *get_memory_resource(const std::pmr::polymorphic_allocator<value_t> &allocator)
+    {
+        return allocator.resource();
+    }
 };
+#endif
 
 // ------------------------------------------------------------------------------------------------------------- //
 //                                  	DEFAULT ADAPTERS FOR COMMON STD CLASSES                             	 //
@@ -1082,12 +1740,114 @@ struct access<std::unique_ptr<T>, 0> : std::true_type
     {
         return member_display_type::pointer_edge;
     }
+    static constexpr pointer_ownership get_pointer_ownership()
+    {
+        return pointer_ownership::exclusive;
+    }
     static bool display_member(const std::unique_ptr<T> &)
     {
         return true;
     }
 };
 
+// std::shared_ptr<T>
+template <typename T>
+struct access<std::shared_ptr<T>, 0> : std::true_type
+{
+    static auto get_member_name()
+    {
+        return "pointer";
+    }
+    static const T *get_member_value(const std::shared_ptr<T> &instance)
+    {
+        return instance.get();
+    }
+    static constexpr member_display_type get_member_display_type()
+    {
+        return member_display_type::pointer_edge;
+    }
+    static constexpr pointer_ownership get_pointer_ownership()
+    {
+        return pointer_ownership::shared;
+    }
+    static bool display_member(const std::shared_ptr<T> &)
+    {
+        return true;
+    }
+};
+
+// Number of shared pointers sharing the control block, this one included: above 1, the object has other owners.
+template <typename T>
+struct access<std::shared_ptr<T>, 1> : std::true_type
+{
+    static auto get_member_name()
+    {
+        return "use_count()";
+    }
+    static long get_member_value(const std::shared_ptr<T> &instance)
+    {
+        return instance.use_count();
+    }
+    static constexpr member_display_type get_member_display_type()
+    {
+        return member_display_type::inside;
+    }
+    static bool display_member(const std::shared_ptr<T> &)
+    {
+        return true;
+    }
+};
+
+// std::weak_ptr<T>
+template <typename T>
+struct access<std::weak_ptr<T>, 0> : std::true_type
+{
+    static auto get_member_name()
+    {
+        return "pointer";
+    }
+    // Null once the object is destroyed. The data is expected not to change during the traversal: the object stays
+    // alive after the temporary owner is released.
+    static const T *get_member_value(const std::weak_ptr<T> &instance)
+    {
+        return instance.lock().get();
+    }
+    static constexpr member_display_type get_member_display_type()
+    {
+        return member_display_type::pointer_edge;
+    }
+    static constexpr pointer_ownership get_pointer_ownership()
+    {
+        return pointer_ownership::weak;
+    }
+    static bool display_member(const std::weak_ptr<T> &)
+    {
+        return true;
+    }
+};
+
+// Number of shared pointers owning the observed object, 0 once it is destroyed.
+template <typename T>
+struct access<std::weak_ptr<T>, 1> : std::true_type
+{
+    static auto get_member_name()
+    {
+        return "use_count()";
+    }
+    static long get_member_value(const std::weak_ptr<T> &instance)
+    {
+        return instance.use_count();
+    }
+    static constexpr member_display_type get_member_display_type()
+    {
+        return member_display_type::inside;
+    }
+    static bool display_member(const std::weak_ptr<T> &)
+    {
+        return true;
+    }
+};
+
 // std::optional<T>
 template <typename value_t>
 struct access<std::optional<value_t>, 0> : std::true_type
@@ -1136,6 +1896,8 @@ struct access<std::optional<value_t>, 1> : std::true_type
 namespace impl
 {
 constexpr uint64_t nullptr_pointer_node_id = 0;
+// Set in the node IDs of views, which are not addresses (see get_node_id_for_value).
+constexpr uint64_t view_node_id_bit = uint64_t{1} << 63;
 
 template <typename T>
 constexpr bool is_value_type()
@@ -1151,6 +1913,9 @@ constexpr bool is_simple_type_v =
     (std::is_fundamental_v<T> || std::is_constructible_v<std::basic_string<char>, T> ||
      std::is_constructible_v<std::basic_string<wchar_t>, T>)&&!(std::is_pointer_v<T> || std::is_null_pointer_v<T>);
 
+template <typename T>
+constexpr bool always_false_v = false;
+
 template <class T, template <class...> class Template>
 struct is_specialization : std::false_type
 {
@@ -1160,706 +1925,5742 @@ struct is_specialization<Template<Args...>, Template> : std::true_type
 {
 };
 
-template <typename value_t>
-uint64_t get_node_id_for_value(const value_t &value)
+template <typename T>
+constexpr bool is_hash_table_v =
+    is_specialization<T, std::unordered_map>::value || is_specialization<T, std::unordered_multimap>::value;
+
+template <typename T>
+constexpr bool is_ordered_map_v = is_specialization<T, std::map>::value || is_specialization<T, std::multimap>::value;
+
+template <typename T>
+constexpr bool is_vector_of_bool_v = false;
+template <typename allocator_t>
+constexpr bool is_vector_of_bool_v<std::vector<bool, allocator_t>> = true;
+
+template <typename container_t, typename = void>
+struct has_allocator : std::false_type
 {
-    // TODO: check if value_t has a custom node ID computation function.
-    return get_address_as_uint<value_t>(&value);
-}
+};
+template <typename container_t>
+struct has_allocator<container_t, std::void_t<typename container_t::allocator_type>> : std::true_type
+{
+};
 
 /**
- * \tparam data_t Data type to represent.
- * \return If 'data_t' is a pointer type, this function is required to return a pointer arrow. Calling code
- * can safely dereference any pointer corresponding to this.
- * If not, if the class is adapted, this is left to the class's discretion. If it is not adapted, it falls
- * back to the 'inside' representation, and an attempt to call cdv::to_string on the value will be made.
+ * \return True if the characters of the string are stored inside the string object itself (SSO).
  */
-template <typename data_t>
-constexpr member_display_type get_data_display_type()
+template <typename char_t, typename traits_t, typename allocator_t>
+bool is_stored_inline(const std::basic_string<char_t, traits_t, allocator_t> &value)
 {
-    using unqualified_data_t = std::remove_const_t<std::remove_reference_t<std::remove_const_t<data_t>>>;
+    const auto *buffer = reinterpret_cast<const char *>(value.data());
+    const auto *object = reinterpret_cast<const char *>(&value);
+    return buffer >= object && buffer < object + sizeof(value);
+}
 
-    // Pointers => always a pointer arrow (except for null pointers where we just write nullptr).
-    if constexpr (std::is_null_pointer_v<unqualified_data_t>)
-    {
-        return member_display_type::inside;
-    }
-    else if constexpr (std::is_pointer_v<unqualified_data_t>)
-    {
-        return member_display_type::pointer_edge;
-    }
-    // "Big" objects:
-    // - containers
-    // - "big" custom classes
-    // - etc.
-    // => composition edge to avoid gigantic nodes.
-    else if constexpr (traits::is_adapted_v<unqualified_data_t> || traits::is_container_v<unqualified_data_t>)
+/**
+ * \return Bytes allocated for each element of a node-based container on top of the element itself, estimated as the
+ * links between the nodes. 0 for the other containers.
+ */
+template <typename container_t>
+constexpr size_t get_element_link_bytes()
+{
+    if constexpr (is_specialization<container_t, std::list>::value)
     {
-        // TODO : see if the class is big or not. If it is big, use a
-        // TODO : composition edge. If not, use an "inside" representation.
-        return member_display_type::composition_edge;
+        return 2 * sizeof(void *);
     }
-    // Simple value types can be put inside.
-    else if constexpr (impl::is_value_type<unqualified_data_t>())
+    else if constexpr (is_specialization<container_t, std::forward_list>::value)
     {
-        return member_display_type::inside;
+        return sizeof(void *);
     }
-    // By default, try putting stuff inside.
     else
     {
-        return member_display_type::inside;
+        return 0;
     }
 }
 
-} // namespace impl
-
-// ---------------------------------------------- visualization --------------------------------------------- //
-
-template <typename string_t>
-class visualization;
-
-template <typename string_t>
-string_t generate_dot_visualization_string(const visualization<string_t> &);
-
-template <typename string_t>
-class visualization : public cluster<string_t>
+/**
+ * \return Bytes of heap memory directly owned by a value. Only the standard containers known by the library own heap
+ * memory; the node overhead of lists is estimated as their links.
+ */
+template <typename data_t>
+size_t get_owned_heap_bytes(const data_t &value)
 {
-  public:
-    using base_node_t = base_node<string_t>;
-    using cell_t = typename table_node<string_t>::cell;
-
-    visualization() = default;
-
-    // Primitive visualization functions.
-
-    [[nodiscard]] bool has_node(const uint64_t node_id)
+    if constexpr (is_specialization<data_t, std::basic_string>::value)
     {
-        return m_nodes.find(node_id) != m_nodes.end();
+        if (is_stored_inline(value))
+        {
+            return 0;
+        }
+        return (value.capacity() + 1) * sizeof(typename data_t::value_type);
     }
-
-    template <typename node_t>
-    auto add_node(const uint64_t node_id, const node_t &node)
+    else if constexpr (is_vector_of_bool_v<data_t>)
     {
-        return m_nodes.insert_or_assign(node_id, std::make_unique<node_t>(node));
+        return (value.capacity() + CHAR_BIT - 1) / CHAR_BIT;
     }
-
-    template <typename node_t>
-    auto add_node(const uint64_t node_id, node_t &&node)
+    else if constexpr (is_specialization<data_t, std::vector>::value)
     {
-        // Overload for rvalue references, allows us to forward the node instead of copying it.
-        return m_nodes.insert_or_assign(node_id, std::make_unique<node_t>(std::forward<node_t>(node)));
+        return value.capacity() * sizeof(typename data_t::value_type);
     }
-
-    arrow<string_t> &add_edge(const arrow<string_t> &arrow)
+    else if constexpr (is_specialization<data_t, std::list>::value ||
+                       is_specialization<data_t, std::forward_list>::value)
     {
-        m_directed_edges.emplace_back(arrow);
+        const auto length = static_cast<size_t>(std::distance(value.cbegin(), value.cend()));
+        return length * (sizeof(typename data_t::value_type) + get_element_link_bytes<data_t>());
+    }
+    else if constexpr (is_hash_table_v<data_t>)
+    {
+        // The bucket array, and one node per element, linked to the next one.
+        return value.bucket_count() * sizeof(void *) +
+               value.size() * (sizeof(typename data_t::value_type) + sizeof(void *));
+    }
+    else if constexpr (is_ordered_map_v<data_t>)
+    {
+        // One node per element, with its color and its links to its parent and children.
+        return value.size() * (sizeof(typename data_t::value_type) + 4 * sizeof(void *));
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * \return Bytes of the buffer of a std::vector allocated but not used by its elements. 0 for the other containers.
+ */
+template <typename container_t>
+size_t get_slack_bytes(const container_t &container)
+{
+    if constexpr (is_vector_of_bool_v<container_t>)
+    {
+        return (container.capacity() - container.size()) / CHAR_BIT;
+    }
+    else if constexpr (is_specialization<container_t, std::vector>::value)
+    {
+        return (container.capacity() - container.size()) * sizeof(typename container_t::value_type);
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+template <typename data_t>
+memory_footprint make_memory_footprint(const data_t &value)
+{
+    // The memory seen through a view belongs to another object.
+    if constexpr (traits::is_view_v<data_t>)
+    {
+        return {get_type_name<data_t>(), 0, 0};
+    }
+    else
+    {
+        return {get_type_name<data_t>(), sizeof(data_t), get_owned_heap_bytes(value)};
+    }
+}
+
+/**
+ * \return The address displayed for a value: its own, or for a non-empty view (see traits::view), the address of the
+ * values it views.
+ */
+template <typename value_t>
+const void *get_identifying_address(const value_t &value)
+{
+    if constexpr (traits::is_view_v<value_t>)
+    {
+        if (std::data(value) != nullptr)
+        {
+            return std::data(value);
+        }
+    }
+    return &value;
+}
+
+template <typename value_t>
+uint64_t get_node_id_for_value(const value_t &value)
+{
+    // TODO: check if value_t has a custom node ID computation function.
+    // All the null pointers share the same node.
+    if constexpr (std::is_null_pointer_v<value_t>)
+    {
+        return nullptr_pointer_node_id;
+    }
+    else if constexpr (std::is_pointer_v<value_t>)
+    {
+        if (value == nullptr)
+        {
+            return nullptr_pointer_node_id;
+        }
+    }
+    // The viewed values start at the address of their container, or of other views of different lengths: views are
+    // identified by their range and type instead. The top bit keeps them apart from the addresses of the other nodes.
+    else if constexpr (traits::is_view_v<value_t>)
+    {
+        uint64_t node_id = hash_combine(get_address_as_uint(std::data(value)), std::size(value));
+        node_id = hash_combine(node_id, get_address_as_uint(get_type_name<value_t>().data()));
+        return node_id | view_node_id_bit;
+    }
+    return get_address_as_uint(&value);
+}
+
+/**
+ * \tparam data_t Data type to represent.
+ * \return If 'data_t' is a pointer type, this function is required to return a pointer arrow. Calling code
+ * can safely dereference any pointer corresponding to this.
+ * If not, if the class is adapted, this is left to the class's discretion. If it is not adapted, it falls
+ * back to the 'inside' representation, and an attempt to call cdv::to_string on the value will be made.
+ */
+template <typename data_t>
+constexpr member_display_type get_data_display_type()
+{
+    using unqualified_data_t = std::remove_const_t<std::remove_reference_t<std::remove_const_t<data_t>>>;
+
+    // Pointers => always a pointer arrow (except for null pointers where we just write nullptr).
+    if constexpr (std::is_null_pointer_v<unqualified_data_t>)
+    {
+        return member_display_type::inside;
+    }
+    else if constexpr (std::is_pointer_v<unqualified_data_t>)
+    {
+        return member_display_type::pointer_edge;
+    }
+    // "Big" objects:
+    // - containers
+    // - "big" custom classes
+    // - etc.
+    // => composition edge to avoid gigantic nodes.
+    else if constexpr (traits::is_handled_by_cdv_v<unqualified_data_t>)
+    {
+        // TODO : see if the class is big or not. If it is big, use a
+        // TODO : composition edge. If not, use an "inside" representation.
+        return member_display_type::composition_edge;
+    }
+    // Simple value types can be put inside.
+    else if constexpr (impl::is_value_type<unqualified_data_t>())
+    {
+        return member_display_type::inside;
+    }
+    // By default, try putting stuff inside.
+    else
+    {
+        return member_display_type::inside;
+    }
+}
+
+template <typename member_descriptor_t, typename = void>
+struct has_pointer_ownership : std::false_type
+{
+};
+template <typename member_descriptor_t>
+struct has_pointer_ownership<member_descriptor_t,
+                             std::void_t<decltype(member_descriptor_t::get_pointer_ownership())>> : std::true_type
+{
+};
+
+/**
+ * \return How a member pointer owns the object it points to: given by its descriptor for smart pointers, none (raw
+ * pointer) by default.
+ */
+template <typename member_descriptor_t>
+constexpr pointer_ownership get_pointer_ownership()
+{
+    if constexpr (has_pointer_ownership<member_descriptor_t>::value)
+    {
+        return member_descriptor_t::get_pointer_ownership();
+    }
+    else
+    {
+        return pointer_ownership::none;
+    }
+}
+
+template <typename adapted_class_t, size_t member_index = 0>
+constexpr size_t get_adapted_member_count()
+{
+    if constexpr (traits::access<adapted_class_t, member_index>::value)
+    {
+        return get_adapted_member_count<adapted_class_t, member_index + 1>();
+    }
+    else
+    {
+        return member_index;
+    }
+}
+
+template <typename adapted_class_t, size_t... member_indices>
+constexpr auto make_access_member_descriptors(std::index_sequence<member_indices...>)
+{
+    // access<> specializations only have static functions: empty instances can be used as descriptors.
+    return traits::member_table<traits::access<adapted_class_t, member_indices>...>{};
+}
+
+/**
+ * \return The tuple of the member descriptors of an adapted class, from CDV_ADAPT_CLASS or from its access<>
+ * specializations.
+ */
+template <typename adapted_class_t>
+constexpr auto get_member_descriptors()
+{
+    if constexpr (traits::members<adapted_class_t>::value)
+    {
+        return traits::members<adapted_class_t>::get();
+    }
+    else
+    {
+        return make_access_member_descriptors<adapted_class_t>(
+            std::make_index_sequence<get_adapted_member_count<adapted_class_t>()>{});
+    }
+}
+
+template <typename adapted_class_t>
+constexpr size_t adapted_member_count_v = decltype(get_member_descriptors<adapted_class_t>())::size;
+
+/**
+ * Renders the table of an adapted class from its type name and member names. Only instantiated per string type, the
+ * per-class part being limited to gathering the names (see get_adapted_class_skeleton).
+ */
+template <typename string_t>
+adapted_class_skeleton<string_t> make_adapted_class_skeleton(const string_t &type_name,
+                                                             const std::vector<string_t> &member_names)
+{
+    // |-------------------------------------|
+    // |   <Type name>    |    <Address>     |
+    // |-------------------------------------|
+    // | <Member Name 1>  | <Member Value 1> |  <--- port = "0"
+    // |-------------------------------------|
+    // |             	...             	 |
+    // |-------------------------------------|
+    using cell_t = typename table<string_t>::cell;
+
+    adapted_class_skeleton<string_t> skeleton;
+    skeleton.type_name = type_name;
+    skeleton.member_names = member_names;
+    skeleton.header_opening = table<string_t>{}.generate_table_opening_html_string();
+    skeleton.header_opening += lit(string_t, "<tr>");
+    skeleton.header_opening += generate_table_node_cell_html<string_t>(cell_t{type_name});
+    skeleton.header_opening += generate_table_node_cell_opening_html<string_t>(cell_t{});
+    skeleton.header_closing = lit(string_t, "</td></tr>");
+
+    for (size_t member_index = 0; member_index < member_names.size(); ++member_index)
+    {
+        skeleton.port_names.emplace_back(cdv::to_string<string_t>(member_index));
+        string_t row_opening = lit(string_t, "<tr>");
+        row_opening += generate_table_node_cell_html<string_t>(cell_t{member_names[member_index]});
+        row_opening += generate_table_node_cell_opening_html<string_t>(
+            cell_t{}.with_port(skeleton.port_names[member_index]));
+        skeleton.member_row_openings.emplace_back(std::move(row_opening));
+    }
+    skeleton.member_row_closing = lit(string_t, "</td></tr>");
+    skeleton.table_closing = lit(string_t, "</table>");
+    return skeleton;
+}
+
+template <typename string_t, size_t... member_indices, typename... member_descriptors_t>
+std::vector<string_t> get_adapted_member_names(
+    const traits::member_table_entries<std::index_sequence<member_indices...>, member_descriptors_t...> &member_table)
+{
+    return {cdv::to_string<string_t>(
+        static_cast<const traits::member_table_entry<member_indices, member_descriptors_t> &>(member_table)
+            .descriptor.get_member_name())...};
+}
+
+/**
+ * \return The pre-rendered table of adapted_class_t, built on the first call.
+ */
+template <typename adapted_class_t, typename string_t>
+const adapted_class_skeleton<string_t> &get_adapted_class_skeleton()
+{
+    // Thread-safe initialization, the parallel traversal can build the first instances concurrently.
+    static const adapted_class_skeleton<string_t> skeleton = make_adapted_class_skeleton<string_t>(
+        get_type_name_string<adapted_class_t, string_t>(),
+        get_adapted_member_names<string_t>(get_member_descriptors<adapted_class_t>()));
+    return skeleton;
+}
+
+template <typename member_t>
+const void *get_stored_member_address(const member_t &member)
+{
+    return &member;
+}
+
+// Members returned by value are copies: they do not tell where the member is stored.
+template <typename member_t>
+const void *get_stored_member_address(const member_t &&)
+{
+    return nullptr;
+}
+
+inline void add_member_layout(class_layout &layout, const void *object, std::string member_name, const void *member,
+                              const size_t member_size)
+{
+    const auto *object_begin = static_cast<const char *>(object);
+    const auto *member_begin = static_cast<const char *>(member);
+    if (member != nullptr && member_begin >= object_begin && member_begin + member_size <= object_begin + layout.size)
+    {
+        const auto offset = static_cast<size_t>(member_begin - object_begin);
+        layout.members.push_back({std::move(member_name), offset, member_size});
+    }
+    else
+    {
+        layout.unlocated_member_names.emplace_back(std::move(member_name));
+    }
+}
+
+template <typename adapted_class_t, typename... member_descriptors_t>
+class_layout make_class_layout_from_descriptors(const adapted_class_t &instance,
+                                                const member_descriptors_t &...member_descriptors)
+{
+    class_layout layout{get_type_name<adapted_class_t>(), sizeof(adapted_class_t), alignof(adapted_class_t)};
+    (add_member_layout(layout, &instance, cdv::to_string<std::string>(member_descriptors.get_member_name()),
+                       member_descriptors.display_member(instance)
+                           ? get_stored_member_address(member_descriptors.get_member_value(instance))
+                           : nullptr,
+                       sizeof(decltype(member_descriptors.get_member_value(instance)))),
+     ...);
+    std::stable_sort(layout.members.begin(), layout.members.end(),
+                     [](const member_layout &lhs, const member_layout &rhs) { return lhs.offset < rhs.offset; });
+    return layout;
+}
+
+template <typename adapted_class_t, size_t... member_indices, typename... member_descriptors_t>
+class_layout make_class_layout(
+    const adapted_class_t &instance,
+    const traits::member_table_entries<std::index_sequence<member_indices...>, member_descriptors_t...> &member_table)
+{
+    return make_class_layout_from_descriptors(
+        instance,
+        static_cast<const traits::member_table_entry<member_indices, member_descriptors_t> &>(member_table)
+            .descriptor...);
+}
+
+/**
+ * \return The layout of adapted_class_t, measured on the instance given to the first call: the members are at the same
+ * offsets in all the instances.
+ */
+template <typename adapted_class_t>
+const class_layout &get_class_layout(const adapted_class_t &instance)
+{
+    static const class_layout layout = make_class_layout(instance, get_member_descriptors<adapted_class_t>());
+    return layout;
+}
+
+/**
+ * Calls function on each member descriptor of a member table, in declaration order.
+ */
+template <typename function_t, size_t... member_indices, typename... member_descriptors_t>
+void for_each_member_descriptor(
+    const traits::member_table_entries<std::index_sequence<member_indices...>, member_descriptors_t...> &member_table,
+    function_t &&function)
+{
+    (function(static_cast<const traits::member_table_entry<member_indices, member_descriptors_t> &>(member_table)
+                  .descriptor),
+     ...);
+}
+
+template <typename container_t>
+constexpr bool is_random_access_container_v = std::is_base_of_v<
+    std::random_access_iterator_tag,
+    typename std::iterator_traits<decltype(std::cbegin(std::declval<const container_t &>()))>::iterator_category>;
+
+/**
+ * Runs task(task_index) for every task_index in [0, task_count), on at most thread_count threads. The calling thread is
+ * one of them.
+ * Each worker starts with a contiguous block of task indices, and pops tasks from the front of its block. Once its
+ * block is empty, it steals tasks from the back of the other workers' blocks, so that the workers finishing early
+ * take over the work of the slow ones.
+ * \note No task is ever created while running, so a worker can exit once all the blocks are empty.
+ */
+template <typename task_t>
+void run_work_stealing(const size_t task_count, const size_t thread_count, task_t &&task)
+{
+    struct task_block
+    {
+        std::mutex mutex{};
+        size_t next{0};
+        size_t end{0};
+    };
+
+    const size_t worker_count = std::max<size_t>(1, std::min(thread_count, task_count));
+    std::vector<task_block> blocks(worker_count);
+    for (size_t worker_index = 0; worker_index < worker_count; ++worker_index)
+    {
+        blocks[worker_index].next = task_count * worker_index / worker_count;
+        blocks[worker_index].end = task_count * (worker_index + 1) / worker_count;
+    }
+
+    const auto work = [&blocks, &task, worker_count](const size_t worker_index) {
+        // 1. Own block, from the front.
+        for (;;)
+        {
+            size_t task_index;
+            {
+                std::lock_guard<std::mutex> lock{blocks[worker_index].mutex};
+                if (blocks[worker_index].next == blocks[worker_index].end)
+                {
+                    break;
+                }
+                task_index = blocks[worker_index].next++;
+            }
+            task(task_index);
+        }
+
+        // 2. Other blocks, from the back.
+        for (size_t offset = 1; offset < worker_count; ++offset)
+        {
+            task_block &victim = blocks[(worker_index + offset) % worker_count];
+            for (;;)
+            {
+                size_t task_index;
+                {
+                    std::lock_guard<std::mutex> lock{victim.mutex};
+                    if (victim.next == victim.end)
+                    {
+                        break;
+                    }
+                    task_index = --victim.end;
+                }
+                task(task_index);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(worker_count - 1);
+    for (size_t worker_index = 1; worker_index < worker_count; ++worker_index)
+    {
+        threads.emplace_back(work, worker_index);
+    }
+    work(0);
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+template <typename container_t, typename = void>
+struct has_contiguous_data : std::false_type
+{
+};
+template <typename container_t>
+struct has_contiguous_data<container_t, std::void_t<decltype(std::data(std::declval<const container_t &>()))>>
+    : std::true_type
+{
+};
+
+// Numbers summarized by visualization::set_numeric_summary: all the arithmetic types but bool.
+template <typename value_t>
+constexpr bool is_summarizable_number_v = std::is_arithmetic_v<value_t> && !std::is_same_v<value_t, bool>;
+
+// Numbers formatted by append_bulk_values: the arithmetic types std::to_chars supports.
+template <typename value_t>
+constexpr bool has_bulk_formatting_v = is_summarizable_number_v<value_t> && !std::is_same_v<value_t, wchar_t> &&
+                                       !std::is_same_v<value_t, char16_t> && !std::is_same_v<value_t, char32_t>;
+
+/**
+ * Appends the value to values, with the same text as cdv::to_string, and its end to value_ends (see table::row). The
+ * value is formatted with std::to_chars into a buffer on the stack, and appended at once: no string is built for it.
+ */
+template <typename string_t, typename value_t>
+void append_bulk_value(string_t &values, std::vector<size_t> &value_ends, const value_t value)
+{
+    // Room for the fixed notation of the biggest floating point values.
+    char buffer[std::numeric_limits<value_t>::max_exponent10 + 32];
+    char *const value_first = buffer;
+    char *const buffer_end = std::end(buffer);
+
+    char *value_last;
+    if constexpr (std::is_floating_point_v<value_t>)
+    {
+#if defined(__cpp_lib_to_chars)
+        // Six decimals, like std::to_string.
+        value_last = std::to_chars(value_first, buffer_end, value, std::chars_format::fixed, 6).ptr;
+#else
+        const auto available = static_cast<size_t>(buffer_end - value_first);
+        const int length = std::is_same_v<value_t, long double>
+                               ? std::snprintf(value_first, available, "%Lf", static_cast<long double>(value))
+                               : std::snprintf(value_first, available, "%f", static_cast<double>(value));
+        value_last = value_first + length;
+#endif
+    }
+    else
+    {
+        value_last = std::to_chars(value_first, buffer_end, value).ptr;
+    }
+    values.append(value_first, value_last);
+    value_ends.push_back(values.size());
+}
+
+/**
+ * Appends the values, see append_bulk_value.
+ */
+template <typename string_t, typename value_t>
+void append_bulk_values(string_t &values, std::vector<size_t> &value_ends, const value_t *data, const size_t count)
+{
+    // At least a few characters per value.
+    values.reserve(values.size() + count * 4);
+    value_ends.reserve(value_ends.size() + count);
+    for (size_t index = 0; index < count; ++index)
+    {
+        append_bulk_value(values, value_ends, data[index]);
+    }
+}
+
+// Rows of the matrices displayed by visualization::set_matrix_display: contiguous containers of numbers.
+template <typename row_t, typename = void>
+constexpr bool is_matrix_row_v = false;
+template <typename row_t>
+constexpr bool is_matrix_row_v<row_t, std::enable_if_t<traits::is_linear_container_v<row_t>>> =
+    has_contiguous_data<row_t>::value && is_summarizable_number_v<typename row_t::value_type>;
+
+// Splits length rows or columns into block_count blocks of matrix cells, whose lengths differ by one at most.
+// Block i starts at starts[i] and ends at starts[i + 1].
+inline std::vector<size_t> get_block_starts(const size_t length, const size_t block_count)
+{
+    std::vector<size_t> starts(block_count + 1);
+    for (size_t block = 0; block <= block_count; ++block)
+    {
+        starts[block] = block_count == 0 ? 0 : block * length / block_count;
+    }
+    return starts;
+}
+
+// "<Length>" when the blocks have the same length, "<Min>-<Max>" otherwise.
+template <typename string_t>
+[[nodiscard]] string_t get_block_lengths_string(const std::vector<size_t> &starts)
+{
+    size_t min_length = std::numeric_limits<size_t>::max();
+    size_t max_length = 0;
+    for (size_t block = 0; block + 1 < starts.size(); ++block)
+    {
+        min_length = std::min(min_length, starts[block + 1] - starts[block]);
+        max_length = std::max(max_length, starts[block + 1] - starts[block]);
+    }
+    if (min_length >= max_length)
+    {
+        return to_string<string_t>(max_length);
+    }
+    return to_string<string_t>(min_length) + lit(string_t, "-") + to_string<string_t>(max_length);
+}
+
+/**
+ * Statistics of a sequence of numbers. NaNs and infinities are only counted, the other statistics are computed on the
+ * finite values.
+ */
+struct numeric_statistics
+{
+    size_t finite_count{0};
+    size_t nan_count{0};
+    size_t infinity_count{0};
+    double min{std::numeric_limits<double>::infinity()};
+    double max{-std::numeric_limits<double>::infinity()};
+    double sum{0.0};
+    double mean{0.0};
+    double standard_deviation{0.0};
+    // Number of finite values in each of the bins of equal width splitting [min, max]. Empty without finite values.
+    std::vector<size_t> histogram{};
+
+    void add(const double value)
+    {
+        if (std::isnan(value))
+        {
+            ++nan_count;
+        }
+        else if (std::isinf(value))
+        {
+            ++infinity_count;
+        }
+        else
+        {
+            ++finite_count;
+            min = std::min(min, value);
+            max = std::max(max, value);
+            sum += value;
+        }
+    }
+
+    [[nodiscard]] double get_bin_start(const size_t bin) const
+    {
+        return min + (max - min) * static_cast<double>(bin) / static_cast<double>(histogram.size());
+    }
+};
+
+#if defined(CDV_SIMD_AVX) || defined(CDV_SIMD_SSE2)
+template <typename value_t>
+constexpr bool has_vectorized_reduction_v = std::is_same_v<value_t, double> || std::is_same_v<value_t, float>;
+#else
+template <typename value_t>
+constexpr bool has_vectorized_reduction_v = false;
+#endif
+
+#if defined(CDV_SIMD_AVX)
+template <typename value_t>
+__m256d load_as_doubles(const value_t *values)
+{
+    if constexpr (std::is_same_v<value_t, double>)
+    {
+        return _mm256_loadu_pd(values);
+    }
+    else
+    {
+        return _mm256_cvtps_pd(_mm_loadu_ps(values));
+    }
+}
+
+/**
+ * Adds the count values to the statistics, 4 at a time. Only the values of the last incomplete group are added one by
+ * one.
+ */
+template <typename value_t>
+void add_vectorized(numeric_statistics &statistics, const value_t *values, const size_t count)
+{
+    constexpr size_t lane_count = 4;
+    const __m256d zeros = _mm256_setzero_pd();
+    const __m256d ones = _mm256_set1_pd(1.0);
+    const __m256d positive_infinities = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    const __m256d negative_infinities = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+    // Counts are kept in doubles, exact up to 2^53.
+    __m256d finite_counts = zeros;
+    __m256d nan_counts = zeros;
+    __m256d mins = positive_infinities;
+    __m256d maxs = negative_infinities;
+    __m256d sums = zeros;
+
+    size_t index = 0;
+    for (; index + lane_count <= count; index += lane_count)
+    {
+        const __m256d value = load_as_doubles(values + index);
+        // value - value is 0 for finite values, NaN for NaNs and infinities.
+        const __m256d is_finite = _mm256_cmp_pd(_mm256_sub_pd(value, value), zeros, _CMP_EQ_OQ);
+        const __m256d is_nan = _mm256_cmp_pd(value, value, _CMP_UNORD_Q);
+        finite_counts = _mm256_add_pd(finite_counts, _mm256_and_pd(is_finite, ones));
+        nan_counts = _mm256_add_pd(nan_counts, _mm256_and_pd(is_nan, ones));
+        mins = _mm256_min_pd(mins, _mm256_blendv_pd(positive_infinities, value, is_finite));
+        maxs = _mm256_max_pd(maxs, _mm256_blendv_pd(negative_infinities, value, is_finite));
+        sums = _mm256_add_pd(sums, _mm256_and_pd(value, is_finite));
+    }
+
+    alignas(32) double lanes[5][lane_count];
+    _mm256_store_pd(lanes[0], finite_counts);
+    _mm256_store_pd(lanes[1], nan_counts);
+    _mm256_store_pd(lanes[2], mins);
+    _mm256_store_pd(lanes[3], maxs);
+    _mm256_store_pd(lanes[4], sums);
+    for (size_t lane = 0; lane < lane_count; ++lane)
+    {
+        statistics.finite_count += static_cast<size_t>(lanes[0][lane]);
+        statistics.nan_count += static_cast<size_t>(lanes[1][lane]);
+        statistics.min = std::min(statistics.min, lanes[2][lane]);
+        statistics.max = std::max(statistics.max, lanes[3][lane]);
+        statistics.sum += lanes[4][lane];
+    }
+    statistics.infinity_count += index - static_cast<size_t>(lanes[0][0] + lanes[0][1] + lanes[0][2] + lanes[0][3]) -
+                                 static_cast<size_t>(lanes[1][0] + lanes[1][1] + lanes[1][2] + lanes[1][3]);
+
+    for (; index < count; ++index)
+    {
+        statistics.add(static_cast<double>(values[index]));
+    }
+}
+#elif defined(CDV_SIMD_SSE2)
+template <typename value_t>
+__m128d load_as_doubles(const value_t *values)
+{
+    if constexpr (std::is_same_v<value_t, double>)
+    {
+        return _mm_loadu_pd(values);
+    }
+    else
+    {
+        // Loads the two floats as a single 64-bit integer.
+        return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(values))));
+    }
+}
+
+/**
+ * Adds the count values to the statistics, 2 at a time. Only the last value of an odd count is added alone.
+ */
+template <typename value_t>
+void add_vectorized(numeric_statistics &statistics, const value_t *values, const size_t count)
+{
+    constexpr size_t lane_count = 2;
+    const __m128d zeros = _mm_setzero_pd();
+    const __m128d ones = _mm_set1_pd(1.0);
+    const __m128d positive_infinities = _mm_set1_pd(std::numeric_limits<double>::infinity());
+    const __m128d negative_infinities = _mm_set1_pd(-std::numeric_limits<double>::infinity());
+    // Counts are kept in doubles, exact up to 2^53.
+    __m128d finite_counts = zeros;
+    __m128d nan_counts = zeros;
+    __m128d mins = positive_infinities;
+    __m128d maxs = negative_infinities;
+    __m128d sums = zeros;
+
+    size_t index = 0;
+    for (; index + lane_count <= count; index += lane_count)
+    {
+        const __m128d value = load_as_doubles(values + index);
+        // value - value is 0 for finite values, NaN for NaNs and infinities.
+        const __m128d is_finite = _mm_cmpeq_pd(_mm_sub_pd(value, value), zeros);
+        const __m128d is_nan = _mm_cmpunord_pd(value, value);
+        const __m128d finite_values = _mm_and_pd(is_finite, value);
+        finite_counts = _mm_add_pd(finite_counts, _mm_and_pd(is_finite, ones));
+        nan_counts = _mm_add_pd(nan_counts, _mm_and_pd(is_nan, ones));
+        mins = _mm_min_pd(mins, _mm_or_pd(finite_values, _mm_andnot_pd(is_finite, positive_infinities)));
+        maxs = _mm_max_pd(maxs, _mm_or_pd(finite_values, _mm_andnot_pd(is_finite, negative_infinities)));
+        sums = _mm_add_pd(sums, finite_values);
+    }
+
+    alignas(16) double lanes[5][lane_count];
+    _mm_store_pd(lanes[0], finite_counts);
+    _mm_store_pd(lanes[1], nan_counts);
+    _mm_store_pd(lanes[2], mins);
+    _mm_store_pd(lanes[3], maxs);
+    _mm_store_pd(lanes[4], sums);
+    for (size_t lane = 0; lane < lane_count; ++lane)
+    {
+        statistics.finite_count += static_cast<size_t>(lanes[0][lane]);
+        statistics.nan_count += static_cast<size_t>(lanes[1][lane]);
+        statistics.min = std::min(statistics.min, lanes[2][lane]);
+        statistics.max = std::max(statistics.max, lanes[3][lane]);
+        statistics.sum += lanes[4][lane];
+    }
+    statistics.infinity_count += index - static_cast<size_t>(lanes[0][0] + lanes[0][1]) -
+                                 static_cast<size_t>(lanes[1][0] + lanes[1][1]);
+
+    for (; index < count; ++index)
+    {
+        statistics.add(static_cast<double>(values[index]));
+    }
+}
+#endif
+
+/**
+ * \return The statistics of the numbers in [first, last). The counts, min, max and sum are computed in a first pass,
+ * vectorized for contiguous doubles and floats; the histogram and the standard deviation in a second one.
+ * \param bin_count Number of bins of the histogram, at least 1.
+ */
+template <typename iterator_t>
+numeric_statistics compute_numeric_statistics(const iterator_t first, const iterator_t last, const size_t bin_count)
+{
+    using value_t = std::remove_cv_t<typename std::iterator_traits<iterator_t>::value_type>;
+
+    numeric_statistics statistics;
+    if constexpr (std::is_pointer_v<iterator_t> && has_vectorized_reduction_v<value_t>)
+    {
+        add_vectorized(statistics, first, static_cast<size_t>(last - first));
+    }
+    else
+    {
+        for (auto value = first; value != last; ++value)
+        {
+            statistics.add(static_cast<double>(*value));
+        }
+    }
+
+    if (statistics.finite_count == 0)
+    {
+        return statistics;
+    }
+    statistics.mean = statistics.sum / static_cast<double>(statistics.finite_count);
+    // A single bin when all the finite values are equal.
+    statistics.histogram.assign(statistics.max > statistics.min ? bin_count : 1, 0);
+
+    // Deviations from the mean rather than the sum of the squares, which loses precision.
+    const double bins_per_unit =
+        statistics.max > statistics.min ? static_cast<double>(bin_count) / (statistics.max - statistics.min) : 0.0;
+    double squared_deviations = 0.0;
+    for (auto element = first; element != last; ++element)
+    {
+        const auto value = static_cast<double>(*element);
+        if (std::isfinite(value))
+        {
+            squared_deviations += (value - statistics.mean) * (value - statistics.mean);
+            const auto bin = static_cast<size_t>((value - statistics.min) * bins_per_unit);
+            ++statistics.histogram[std::min(bin, statistics.histogram.size() - 1)];
+        }
+    }
+    statistics.standard_deviation = std::sqrt(squared_deviations / static_cast<double>(statistics.finite_count));
+    return statistics;
+}
+
+} // namespace impl
+
+// ---------------------------------------------- visualization --------------------------------------------- //
+
+/**
+ * How the values of a block of a matrix are combined into the value of its cell, see visualization::set_matrix_display.
+ */
+enum class matrix_pooling
+{
+    min,
+    max,
+    mean,
+};
+
+/**
+ * State of a capture started with visualization::begin_capture.
+ */
+enum class capture_status
+{
+    /**
+     * Some data remains to be traversed. Call visualization::step again.
+     */
+    in_progress,
+    /**
+     * The whole data structure has been traversed.
+     */
+    complete,
+    /**
+     * The version of the data changed between two steps. The capture was abandoned, and the nodes captured so far are
+     * not consistent with each other.
+     */
+    invalidated,
+};
+
+/**
+ * How the node IDs are written in the generated DOT.
+ */
+enum class node_id_format
+{
+    /**
+     * The node ID itself, ie the address of the data, in decimal. Up to 20 characters, and different from one run to
+     * the other.
+     */
+    address,
+    /**
+     * Dense sequential numbers, in the order the nodes were added, in decimal.
+     */
+    sequential_decimal,
+    /**
+     * Dense sequential numbers, in the order the nodes were added, in base 36 prefixed with 'n' (a DOT ID cannot
+     * start with a digit unless it is a number).
+     */
+    sequential_base36,
+};
+
+/**
+ * Memory regions whose nodes are drawn together, in a cluster per region. Shows how the objects are spread in memory:
+ * fragmentation, structures sharing pages, etc.
+ */
+enum class memory_region_grouping
+{
+    /**
+     * No clusters.
+     */
+    none,
+    /**
+     * One cluster per 4KB page.
+     */
+    page,
+    /**
+     * One cluster per 2MB huge page.
+     */
+    huge_page,
+    /**
+     * One cluster per arena registered with visualization::add_memory_arena. The nodes of the objects out of the
+     * arenas are not grouped.
+     */
+    arena,
+};
+
+struct dot_export_options
+{
+    node_id_format node_ids{node_id_format::address};
+    // Objects are grouped by the region of their first byte. Nodes added by hand are not grouped.
+    memory_region_grouping memory_regions{memory_region_grouping::none};
+    // Outlines the nodes of the false sharing candidates, see visualization::find_false_sharing_candidates.
+    bool highlight_false_sharing{false};
+    // Replaces the nodes of each strongly connected component of at least this many nodes (doubly-linked lists, webs
+    // of objects pointing to each other) by a single node counting them per type. 0 to keep all the nodes.
+    size_t collapsed_component_min_size{0};
+    // Replaces the inner nodes of each chain of at least this many nodes by a single "N x T" node, keeping the first
+    // and last nodes. A chain is a path of nodes having a single incoming and outgoing edge, of the same type or
+    // alternating between two types (like the nodes of a list and the smart pointers linking them). 0 to keep all the
+    // nodes; chains are at least 3 nodes long.
+    size_t folded_chain_min_length{0};
+    // Writes identical subgraphs once, with the number of copies next to their root: value-identical objects, for
+    // example the default elements of a vector, share a single node. Nodes are identical if they only differ by their
+    // address, and their edges lead to identical nodes. Nodes in cycles are never merged.
+    bool merge_identical_subgraphs{false};
+    // Note: the streaming mode writes each node as soon as it is built, and ignores the options above.
+};
+
+struct svg_export_options
+{
+    // Time given to the reduction of edge crossings. When it runs out, the order with the fewest crossings found so
+    // far is kept. The other steps of the layout take a time linear in the size of the graph.
+    std::chrono::milliseconds crossing_reduction_budget{1000};
+    // Maximum number of sweeps of the crossing reduction, each one reordering all the ranks once.
+    size_t max_crossing_reduction_sweeps{24};
+    // Edges spanning more ranks than this are drawn as straight lines, rather than routed between the nodes of the
+    // ranks they cross. They are not taken into account by the crossing reduction. Keeps the layout small when long
+    // cycles make edges span thousands of ranks.
+    size_t max_routed_edge_span{16};
+    // Size of the text, in pixels. Tables are sized from the number of characters of their cells, in a monospace font.
+    double font_size{14.0};
+    double cell_padding{4.0};
+    // Minimum horizontal space between two nodes of the same rank, and vertical space between two ranks, in pixels.
+    double node_separation{20.0};
+    double rank_separation{50.0};
+};
+
+/**
+ * Memory used by all the instances of a type in a visualization, see visualization::get_memory_usage_by_type.
+ */
+struct type_memory_usage
+{
+    std::string_view type_name{};
+    size_t instance_count{0};
+    // sizeof the type, times the number of instances.
+    size_t object_bytes{0};
+    // Part of object_bytes stored inside the object or the heap memory of other instances (container elements,
+    // members displayed in their own node), and therefore already counted with them.
+    size_t embedded_bytes{0};
+    size_t heap_bytes{0};
+
+    /**
+     * \return Memory used by the instances and not counted by other types. Summing it over all the types gives the
+     * memory used by the whole graph.
+     */
+    [[nodiscard]] size_t get_total_bytes() const
+    {
+        return object_bytes - embedded_bytes + heap_bytes;
+    }
+};
+
+[[nodiscard]] std::string generate_memory_report_string(const std::vector<type_memory_usage> &usages);
+
+/**
+ * Distances between the objects linked in a data structure, ie between each element of a list and the next one, and
+ * between each pointer and the object it points to. Tells whether following the links stays within the same cache
+ * lines and memory pages, or jumps around the heap. See visualization::get_locality_by_type.
+ */
+struct locality_metrics
+{
+    static constexpr size_t cache_line_bytes = 64;
+    static constexpr size_t page_bytes = 4096;
+    // Upper bounds of the bins of stride_histogram, the last bin holding longer strides.
+    static constexpr std::array<uint64_t, 4> stride_bin_limits{64, 4096, uint64_t{1} << 21, uint64_t{1} << 30};
+
+    // C++ name of the type of the linked objects: the list for its elements, the pointed type for pointers.
+    std::string_view type_name{};
+    size_t hop_count{0};
+    size_t same_cache_line_hop_count{0};
+    size_t same_page_hop_count{0};
+    // Hops to a higher address, in the direction hardware prefetchers follow.
+    size_t forward_hop_count{0};
+    // Number of hops by distance: < 64 B, < 4 KB, < 2 MB, < 1 GB, >= 1 GB.
+    std::array<size_t, stride_bin_limits.size() + 1> stride_histogram{};
+
+    void add_hop(const uint64_t from_address, const uint64_t to_address)
+    {
+        const uint64_t stride = to_address >= from_address ? to_address - from_address : from_address - to_address;
+        ++hop_count;
+        same_cache_line_hop_count += from_address / cache_line_bytes == to_address / cache_line_bytes;
+        same_page_hop_count += from_address / page_bytes == to_address / page_bytes;
+        forward_hop_count += to_address > from_address;
+        size_t bin = 0;
+        while (bin < stride_bin_limits.size() && stride >= stride_bin_limits[bin])
+        {
+            ++bin;
+        }
+        ++stride_histogram[bin];
+    }
+
+    void merge(const locality_metrics &other)
+    {
+        hop_count += other.hop_count;
+        same_cache_line_hop_count += other.same_cache_line_hop_count;
+        same_page_hop_count += other.same_page_hop_count;
+        forward_hop_count += other.forward_hop_count;
+        for (size_t bin = 0; bin < stride_histogram.size(); ++bin)
+        {
+            stride_histogram[bin] += other.stride_histogram[bin];
+        }
+    }
+
+    /**
+     * \return Between 0 and 1: 1 if all the hops stay in the same cache line, 0.5 if they stay in the same page, 0 if
+     * they all land on another page. A low score on a big structure calls for an arena or a flat layout.
+     */
+    [[nodiscard]] double get_locality_score() const
+    {
+        if (hop_count == 0)
+        {
+            return 1.0;
+        }
+        const auto close_hop_count = static_cast<double>(same_cache_line_hop_count + same_page_hop_count);
+        return close_hop_count / static_cast<double>(2 * hop_count);
+    }
+};
+
+[[nodiscard]] std::string generate_locality_report_string(const std::vector<locality_metrics> &metrics);
+
+/**
+ * Layout of an adapted class and number of its instances in a visualization, see visualization::get_class_layouts.
+ */
+struct class_layout_usage
+{
+    const class_layout *layout{nullptr};
+    size_t instance_count{0};
+
+    /**
+     * \return Bytes of the holes of the layout, times the number of instances.
+     */
+    [[nodiscard]] size_t get_total_hole_bytes() const
+    {
+        return layout->get_hole_bytes() * instance_count;
+    }
+};
+
+[[nodiscard]] std::string generate_class_layout_report_string(const std::vector<class_layout_usage> &usages);
+
+/**
+ * Node keeping memory alive, see dominator_tree::get_top_retainers.
+ */
+struct retainer
+{
+    uint64_t node_id{0};
+    std::string_view type_name{};
+    // Memory of the node itself, as counted by get_memory_usage_by_type.
+    size_t shallow_bytes{0};
+    // Memory that would be freed along with the node: its own, and the one of all the nodes it dominates.
+    size_t retained_bytes{0};
+};
+
+/**
+ * Dominator tree of the nodes reachable from the roots of a visualization, with the memory retained by each node. A
+ * node dominates another one if all the paths from the roots to the latter go through the former. The vectors are
+ * indexed by position in node_ids.
+ */
+struct dominator_tree
+{
+    static constexpr size_t no_dominator = std::numeric_limits<size_t>::max();
+
+    // Nodes reachable from the roots, in depth-first order from the roots.
+    std::vector<uint64_t> node_ids;
+    // Position of the immediate dominator of each node, or no_dominator for the nodes only dominated by the roots as
+    // a whole (the roots themselves, and the nodes shared between several roots).
+    std::vector<size_t> immediate_dominators;
+    std::vector<std::string_view> type_names;
+    std::vector<size_t> shallow_bytes;
+    std::vector<size_t> retained_bytes;
+
+    /**
+     * \return The count nodes retaining the most memory, by decreasing retained bytes.
+     */
+    [[nodiscard]] std::vector<retainer> get_top_retainers(const size_t count) const
+    {
+        std::vector<size_t> positions(node_ids.size());
+        std::iota(positions.begin(), positions.end(), size_t{0});
+        const size_t retainer_count = std::min(count, positions.size());
+        std::partial_sort(positions.begin(), positions.begin() + retainer_count, positions.end(),
+                          [this](const size_t lhs, const size_t rhs) {
+                              if (retained_bytes[lhs] != retained_bytes[rhs])
+                              {
+                                  return retained_bytes[lhs] > retained_bytes[rhs];
+                              }
+                              return lhs < rhs;
+                          });
+
+        std::vector<retainer> retainers;
+        retainers.reserve(retainer_count);
+        for (size_t rank = 0; rank < retainer_count; ++rank)
+        {
+            const size_t position = positions[rank];
+            retainers.push_back({node_ids[position], type_names[position], shallow_bytes[position],
+                                 retained_bytes[position]});
+        }
+        return retainers;
+    }
+};
+
+/**
+ * Cycle of owning references going through shared pointers, see visualization::find_reference_cycles.
+ */
+struct reference_cycle
+{
+    // Nodes of the cycle, in node order, and the type of their objects.
+    std::vector<uint64_t> node_ids;
+    std::vector<std::string_view> type_names;
+    // Memory of the nodes of the cycle, as counted by get_memory_usage_by_type.
+    size_t cycle_bytes{0};
+    // Memory kept alive by the cycle: its own, and the one of the nodes only owned by the cycle, directly or not.
+    size_t retained_bytes{0};
+};
+
+/**
+ * \return A text description of the reference cycles: their memory, and the types of their objects.
+ */
+[[nodiscard]] std::string generate_reference_cycle_report_string(const std::vector<reference_cycle> &cycles);
+
+template <typename string_t>
+class visualization;
+
+template <typename string_t>
+string_t generate_dot_visualization_string(const visualization<string_t> &, const dot_export_options & = {});
+
+template <typename string_t>
+string_t generate_svg_visualization_string(const visualization<string_t> &, const svg_export_options & = {});
+
+namespace impl
+{
+template <typename string_t>
+void append_unsigned_integer(string_t &result, uint64_t value, const uint64_t base)
+{
+    constexpr const char *digits = "0123456789abcdefghijklmnopqrstuvwxyz";
+    char buffer[std::numeric_limits<uint64_t>::digits];
+    char *first = std::end(buffer);
+    do
+    {
+        *--first = digits[value % base];
+        value /= base;
+    } while (value != 0);
+    result.append(first, std::end(buffer));
+}
+
+/**
+ * \return The color of a heatmap cell, from white for 0 to red for 1.
+ */
+template <typename string_t>
+string_t get_heat_color(const double heat)
+{
+    constexpr const char *digits = "0123456789abcdef";
+    const auto fade = static_cast<unsigned>(255.0 * (1.0 - std::clamp(heat, 0.0, 1.0)) + 0.5);
+    // Red stays at its maximum, green and blue fade out together.
+    string_t color{lit(string_t, "#ff")};
+    for (size_t component = 0; component < 2; ++component)
+    {
+        color += static_cast<typename string_t::value_type>(digits[fade / 16]);
+        color += static_cast<typename string_t::value_type>(digits[fade % 16]);
+    }
+    return color;
+}
+
+/**
+ * Writes the node IDs in the format requested by the export options. Sequential numbers are given to the node IDs in
+ * the order they are first written.
+ */
+template <typename string_t>
+class node_id_writer
+{
+  public:
+    explicit node_id_writer(const node_id_format format = node_id_format::address)
+        : m_format{format}
+    {
+    }
+
+    void append(string_t &result, const uint64_t node_id)
+    {
+        if (m_format == node_id_format::address)
+        {
+            append_unsigned_integer(result, node_id, 10);
+            return;
+        }
+
+        const uint64_t number = m_numbers.try_emplace(node_id, m_numbers.size()).first->second;
+        if (m_format == node_id_format::sequential_decimal)
+        {
+            append_unsigned_integer(result, number, 10);
+        }
+        else
+        {
+            result += lit(string_t, "n");
+            append_unsigned_integer(result, number, 36);
+        }
+    }
+
+    void reserve(const size_t node_count)
+    {
+        if (m_format != node_id_format::address)
+        {
+            m_numbers.reserve(node_count);
+        }
+    }
+
+  private:
+    node_id_format m_format;
+    std::unordered_map<uint64_t, uint64_t> m_numbers;
+};
+
+/**
+ * Immediate dominators of the vertices reachable from a root, in depth-first preorder numbering.
+ */
+struct dominators
+{
+    // Vertices reachable from the root, by preorder number. The root is first.
+    std::vector<uint32_t> preorder_vertices;
+    // Preorder number of the immediate dominator of each vertex. The root is its own dominator.
+    std::vector<uint32_t> immediate_dominators;
+};
+
+/**
+ * Computes the dominators of a graph with the Lengauer-Tarjan algorithm, using path compression: O(m log n) for n
+ * vertices and m edges. Iterative, to support the deep graphs of long linked lists.
+ * \param edge_offsets Edges of the graph in compressed sparse row form: the edges of vertex v are the targets in
+ * [edge_offsets[v], edge_offsets[v + 1]).
+ * \param edge_targets Target vertex of each edge.
+ * \param root Vertex the paths start from.
+ */
+inline dominators compute_dominators(const std::vector<uint32_t> &edge_offsets,
+                                     const std::vector<uint32_t> &edge_targets, const uint32_t root)
+{
+    constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+    const size_t vertex_count = edge_offsets.size() - 1;
+
+    // 1. Depth-first numbering, and parent of each vertex in the depth-first spanning tree.
+    dominators result;
+    std::vector<uint32_t> preorder_numbers(vertex_count, none);
+    std::vector<uint32_t> parents;
+    std::vector<std::pair<uint32_t, uint32_t>> stack; // Vertex, next edge to follow.
+    preorder_numbers[root] = 0;
+    result.preorder_vertices.push_back(root);
+    parents.push_back(none);
+    stack.emplace_back(root, edge_offsets[root]);
+    while (!stack.empty())
+    {
+        const uint32_t vertex = stack.back().first;
+        const uint32_t edge = stack.back().second;
+        if (edge == edge_offsets[vertex + 1])
+        {
+            stack.pop_back();
+            continue;
+        }
+        ++stack.back().second;
+        const uint32_t target = edge_targets[edge];
+        if (preorder_numbers[target] == none)
+        {
+            preorder_numbers[target] = static_cast<uint32_t>(result.preorder_vertices.size());
+            result.preorder_vertices.push_back(target);
+            parents.push_back(preorder_numbers[vertex]);
+            stack.emplace_back(target, edge_offsets[target]);
+        }
+    }
+
+    // 2. Predecessors of each reachable vertex, by preorder number.
+    const auto reachable_count = static_cast<uint32_t>(result.preorder_vertices.size());
+    std::vector<uint32_t> predecessor_offsets(reachable_count + 1, 0);
+    for (const uint32_t vertex : result.preorder_vertices)
+    {
+        for (uint32_t edge = edge_offsets[vertex]; edge < edge_offsets[vertex + 1]; ++edge)
+        {
+            ++predecessor_offsets[preorder_numbers[edge_targets[edge]] + 1];
+        }
+    }
+    std::partial_sum(predecessor_offsets.begin(), predecessor_offsets.end(), predecessor_offsets.begin());
+    std::vector<uint32_t> predecessors(predecessor_offsets.back());
+    std::vector<uint32_t> predecessor_ends(predecessor_offsets.begin(), predecessor_offsets.end() - 1);
+    for (uint32_t number = 0; number < reachable_count; ++number)
+    {
+        const uint32_t vertex = result.preorder_vertices[number];
+        for (uint32_t edge = edge_offsets[vertex]; edge < edge_offsets[vertex + 1]; ++edge)
+        {
+            predecessors[predecessor_ends[preorder_numbers[edge_targets[edge]]]++] = number;
+        }
+    }
+
+    // 3. Semi-dominators, and immediate dominators when they can be deduced from them. From here on, vertices are
+    // designated by their preorder number.
+    std::vector<uint32_t> semi_dominators(reachable_count);
+    std::vector<uint32_t> labels(reachable_count);
+    std::iota(semi_dominators.begin(), semi_dominators.end(), uint32_t{0});
+    std::iota(labels.begin(), labels.end(), uint32_t{0});
+    std::vector<uint32_t> ancestors(reachable_count, none);
+    std::vector<uint32_t> bucket_heads(reachable_count, none);
+    std::vector<uint32_t> bucket_nexts(reachable_count, none);
+    result.immediate_dominators.assign(reachable_count, 0);
+    std::vector<uint32_t> compressed_path;
+
+    // Vertex of minimal semi-dominator on the path from the root of v's tree in the forest to v, root excluded.
+    const auto evaluate = [&](const uint32_t v) {
+        if (ancestors[v] == none)
+        {
+            return v;
+        }
+        uint32_t x = v;
+        while (ancestors[ancestors[x]] != none)
+        {
+            compressed_path.push_back(x);
+            x = ancestors[x];
+        }
+        while (!compressed_path.empty())
+        {
+            x = compressed_path.back();
+            compressed_path.pop_back();
+            const uint32_t ancestor = ancestors[x];
+            if (semi_dominators[labels[ancestor]] < semi_dominators[labels[x]])
+            {
+                labels[x] = labels[ancestor];
+            }
+            ancestors[x] = ancestors[ancestor];
+        }
+        return labels[v];
+    };
+
+    for (uint32_t w = reachable_count - 1; w > 0; --w)
+    {
+        for (uint32_t edge = predecessor_offsets[w]; edge < predecessor_offsets[w + 1]; ++edge)
+        {
+            const uint32_t u = evaluate(predecessors[edge]);
+            semi_dominators[w] = std::min(semi_dominators[w], semi_dominators[u]);
+        }
+        bucket_nexts[w] = bucket_heads[semi_dominators[w]];
+        bucket_heads[semi_dominators[w]] = w;
+
+        const uint32_t parent = parents[w];
+        ancestors[w] = parent;
+        for (uint32_t v = bucket_heads[parent]; v != none; v = bucket_nexts[v])
+        {
+            const uint32_t u = evaluate(v);
+            result.immediate_dominators[v] = semi_dominators[u] < semi_dominators[v] ? u : parent;
+        }
+        bucket_heads[parent] = none;
+    }
+
+    // 4. Remaining immediate dominators, in preorder so that the dominators of the dominators are final.
+    for (uint32_t w = 1; w < reachable_count; ++w)
+    {
+        if (result.immediate_dominators[w] != semi_dominators[w])
+        {
+            result.immediate_dominators[w] = result.immediate_dominators[result.immediate_dominators[w]];
+        }
+    }
+    return result;
+}
+
+/**
+ * Strongly connected components of a graph: all the vertices of a component can reach each other.
+ */
+struct strongly_connected_components
+{
+    // Component of each vertex. The components are numbered in reverse topological order: an edge between two
+    // components goes to the one with the lower number.
+    std::vector<uint32_t> vertex_components;
+    uint32_t component_count{0};
+};
+
+/**
+ * Computes the strongly connected components of a graph with Tarjan's algorithm, in O(n + m) for n vertices and m
+ * edges. Iterative, to support the deep graphs of long linked lists.
+ * \param edge_offsets Edges of the graph in compressed sparse row form, see compute_dominators.
+ * \param edge_targets Target vertex of each edge.
+ */
+inline strongly_connected_components find_strongly_connected_components(const std::vector<uint32_t> &edge_offsets,
+                                                                        const std::vector<uint32_t> &edge_targets)
+{
+    constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+    const auto vertex_count = static_cast<uint32_t>(edge_offsets.size() - 1);
+
+    strongly_connected_components result;
+    result.vertex_components.assign(vertex_count, none);
+    std::vector<uint32_t> preorder_numbers(vertex_count, none);
+    // Lowest preorder number reachable from the vertex through the vertices not assigned to a component yet.
+    std::vector<uint32_t> low_links(vertex_count);
+    std::vector<uint32_t> unassigned_vertices; // Visited vertices without a component, in preorder.
+    std::vector<std::pair<uint32_t, uint32_t>> stack; // Vertex, next edge to follow.
+    uint32_t next_number = 0;
+    for (uint32_t start = 0; start < vertex_count; ++start)
+    {
+        if (preorder_numbers[start] != none)
+        {
+            continue;
+        }
+        preorder_numbers[start] = low_links[start] = next_number++;
+        unassigned_vertices.push_back(start);
+        stack.emplace_back(start, edge_offsets[start]);
+        while (!stack.empty())
+        {
+            const uint32_t vertex = stack.back().first;
+            const uint32_t edge = stack.back().second;
+            if (edge < edge_offsets[vertex + 1])
+            {
+                ++stack.back().second;
+                const uint32_t target = edge_targets[edge];
+                if (preorder_numbers[target] == none)
+                {
+                    preorder_numbers[target] = low_links[target] = next_number++;
+                    unassigned_vertices.push_back(target);
+                    stack.emplace_back(target, edge_offsets[target]);
+                }
+                else if (result.vertex_components[target] == none)
+                {
+                    low_links[vertex] = std::min(low_links[vertex], preorder_numbers[target]);
+                }
+                continue;
+            }
+
+            // All the edges of the vertex are followed.
+            stack.pop_back();
+            if (!stack.empty())
+            {
+                const uint32_t parent = stack.back().first;
+                low_links[parent] = std::min(low_links[parent], low_links[vertex]);
+            }
+            if (low_links[vertex] == preorder_numbers[vertex])
+            {
+                uint32_t member;
+                do
+                {
+                    member = unassigned_vertices.back();
+                    unassigned_vertices.pop_back();
+                    result.vertex_components[member] = result.component_count;
+                } while (member != vertex);
+                ++result.component_count;
+            }
+        }
+    }
+    return result;
+}
+
+// DOT generation functions shared by the export and the streaming mode of the visualization.
+
+template <typename string_t>
+void append_graph_header_dot_string(string_t &result, const cluster<string_t> &graph);
+
+template <typename string_t>
+void append_node_dot_string(string_t &result, uint64_t node_id, const base_node<string_t> &node,
+                            const node_appearance<string_t> &default_node_appearance,
+                            node_id_writer<string_t> &node_id_writer);
+
+template <typename string_t>
+void append_arrow_dot_string(string_t &result, const arrow<string_t> &arrow, node_id_writer<string_t> &node_id_writer);
+
+template <typename string_t>
+void append_graph_footer_dot_string(string_t &result, const std::vector<rank_constraint> &rank_constraints,
+                                    node_id_writer<string_t> &node_id_writer);
+} // namespace impl
+
+template <typename string_t>
+class visualization : public cluster<string_t>
+{
+  public:
+    using base_node_t = base_node<string_t>;
+    using cell_t = typename table_node<string_t>::cell;
+
+    visualization() = default;
+
+    // Primitive visualization functions.
+
+    /**
+     * Reserves the storage for node_count nodes and edge_count edges. Avoids growing the storage while traversing big
+     * data structures, which matters most when the traversal is spread over budgeted capture steps.
+     */
+    void reserve(const size_t node_count, const size_t edge_count)
+    {
+        m_nodes.reserve(node_count);
+        m_node_order.reserve(node_count);
+        m_directed_edges.reserve(edge_count);
+    }
+
+    [[nodiscard]] bool has_node(const uint64_t node_id)
+    {
+        if (m_stream_sink != nullptr)
+        {
+            return m_streamed_node_ids.find(node_id) != m_streamed_node_ids.end();
+        }
+        return m_nodes.find(node_id) != m_nodes.end();
+    }
+
+    /**
+     * Adds a node, or replaces the node with the same ID.
+     * \return True if there was no node with this ID yet.
+     */
+    template <typename node_t>
+    bool add_node(const uint64_t node_id, const node_t &node)
+    {
+        return store_node(node_id, std::make_unique<node_t>(node));
+    }
+
+    template <typename node_t>
+    bool add_node(const uint64_t node_id, node_t &&node)
+    {
+        // Overload for rvalue references, allows us to forward the node instead of copying it.
+        return store_node(node_id, std::make_unique<node_t>(std::forward<node_t>(node)));
+    }
+
+    /**
+     * \note In streaming mode, the edge is written immediately: the returned reference is only valid until the next
+     * edge is added, and modifying it has no effect.
+     */
+    arrow<string_t> &add_edge(const arrow<string_t> &arrow)
+    {
+        if (m_stream_sink != nullptr)
+        {
+            return stream_edge(arrow);
+        }
+        m_directed_edges.emplace_back(arrow);
+        return m_directed_edges[m_directed_edges.size() - 1];
+    }
+
+    arrow<string_t> &add_edge(const arrow<string_t> &&arrow)
+    {
+        if (m_stream_sink != nullptr)
+        {
+            return stream_edge(arrow);
+        }
+        m_directed_edges.emplace_back(std::move(arrow));
         return m_directed_edges[m_directed_edges.size() - 1];
     }
 
-    arrow<string_t> &add_edge(const arrow<string_t> &&arrow)
+    /**
+     * \note In streaming mode, the edges already written are not kept, and the edge is always added.
+     */
+    std::optional<std::reference_wrapper<arrow<string_t>>> add_unique_edge(const arrow<string_t> &arrow)
+    {
+        if (m_stream_sink != nullptr)
+        {
+            return stream_edge(arrow);
+        }
+        const auto iterator = std::find(m_directed_edges.cbegin(), m_directed_edges.cend(), arrow);
+        if (iterator != m_directed_edges.end())
+        {
+            return std::nullopt;
+        }
+        m_directed_edges.emplace_back(arrow);
+        return m_directed_edges[m_directed_edges.size() - 1];
+    }
+
+    void add_rank_constraint(const rank_constraint &constraint)
+    {
+        m_rank_constraints.emplace_back(constraint);
+    }
+
+    void add_rank_constraint(rank_constraint &&constraint)
+    {
+        m_rank_constraints.emplace_back(std::move(constraint));
+    }
+
+    /**
+     * Enables the parallel traversal of big random-access containers (std::vector, std::array) whose elements are
+     * displayed as separate nodes (pointers, adapted classes, containers).
+     * The elements are split into ranges of elements_per_task elements, whose subgraphs are built on a work-stealing
+     * pool, then merged back in element order. The output does not depend on the scheduling of the tasks.
+     * \param thread_count Number of threads to use. 0 uses std::thread::hardware_concurrency(), 1 disables the
+     * parallel traversal (default).
+     * \param elements_per_task Number of elements per task. Containers with fewer than two tasks' worth of elements
+     * are always traversed sequentially.
+     * \note The data structures must not be modified while they are being added.
+     */
+    void set_parallel_traversal(const size_t thread_count, const size_t elements_per_task = 1024)
+    {
+        m_parallel_thread_count = thread_count == 0 ? std::max(1u, std::thread::hardware_concurrency()) : thread_count;
+        m_parallel_elements_per_task = std::max<size_t>(1, elements_per_task);
+    }
+
+    /**
+     * Adds memory details to the nodes of containers and strings: capacity and unused (slack) bytes of std::vector,
+     * per-element allocation overhead of std::list and std::forward_list, and whether strings are stored inline (SSO)
+     * or on the heap.
+     * \param enabled Adds the details if true. Disabled by default.
+     * \param highlighted_slack_bytes Vectors with at least this many slack bytes have their header highlighted.
+     * \note Strings displayed inside the node of an adapted class are not detailed.
+     */
+    void set_capacity_reporting(const bool enabled, const size_t highlighted_slack_bytes = 4096)
+    {
+        m_settings.is_capacity_reporting_enabled = enabled;
+        m_settings.highlighted_slack_bytes = highlighted_slack_bytes;
+    }
+
+    /**
+     * Displays hash tables (std::unordered_map, std::unordered_multimap) as a view of the health of their buckets
+     * instead of their elements: bucket count, load factors, histogram of the number of elements per bucket, and the
+     * keys of the most crowded buckets.
+     * \param enabled Shows the health of the buckets if true. Disabled by default.
+     */
+    void set_hash_table_health(const bool enabled)
+    {
+        m_settings.is_hash_table_health_enabled = enabled;
+    }
+
+    /**
+     * Limits the number of elements displayed by the nodes of key-value containers. The elements of the other ones are
+     * not traversed at all.
+     * \param max_displayed_elements Number of elements displayed, in iteration order. 0 displays all the elements
+     * (default).
+     */
+    void set_key_value_elision(const size_t max_displayed_elements)
+    {
+        m_settings.max_displayed_key_value_elements = max_displayed_elements;
+    }
+
+    /**
+     * Replaces the values of the long containers of numbers by their statistics: min, max, mean, standard deviation,
+     * NaN and infinity counts, and a histogram (see member_display_type::statistics). The statistics of std::vector
+     * and std::array of doubles and floats are computed with SSE2 or AVX instructions when available.
+     * \param min_length Containers of numbers with at least this many elements are summarized. 0 disables the
+     * summaries (default).
+     * \param histogram_bin_count Number of bins of the histogram, splitting the range of the finite values.
+     */
+    void set_numeric_summary(const size_t min_length, const size_t histogram_bin_count = 16)
+    {
+        m_settings.numeric_summary_min_length = min_length;
+        m_settings.numeric_summary_bin_count = std::max<size_t>(1, histogram_bin_count);
+    }
+
+    /**
+     * Displays the containers of rows of numbers, such as std::vector<std::vector<double>> or
+     * std::array<std::array<float, N>, M>, as a single node holding a heatmap of the matrix, instead of one node per
+     * row (see member_display_type::matrix). Matrices bigger than the grid are downsampled: each cell shows a block of
+     * values, pooled into one. Rows of different lengths (jagged rows) are counted and highlighted.
+     * \param max_grid_size Maximum number of rows and columns of the grid. 0 disables the matrices (default).
+     * \param pooling How the finite values of a block are combined. NaNs and infinities are ignored.
+     */
+    void set_matrix_display(const size_t max_grid_size, const matrix_pooling pooling = matrix_pooling::mean)
+    {
+        m_settings.matrix_grid_size = max_grid_size;
+        m_settings.matrix_cell_pooling = pooling;
+    }
+
+    /**
+     * Registers an address range, such as a memory pool or a block of an arena allocator. When exporting with
+     * memory_region_grouping::arena, the nodes of the objects of the range are drawn in a cluster.
+     * \param begin First byte of the range.
+     * \param size Size of the range, in bytes.
+     * \param name Label of the cluster.
+     */
+    void add_memory_arena(const void *begin, const size_t size, const string_t &name)
+    {
+        memory_arena<string_t> arena;
+        arena.begin_address = reinterpret_cast<uint64_t>(begin);
+        arena.end_address = arena.begin_address + size;
+        arena.name = name;
+        arena.appearance.cluster_label = impl::make_dot_quoted_string(name);
+        m_settings.memory_arenas.emplace_back(std::move(arena));
+    }
+
+    /**
+     * Names a memory resource, such as a std::pmr::memory_resource or the arena of a custom allocator (see
+     * traits::memory_resource). The containers allocating from it show this name instead of its address.
+     * \param resource Address of the memory resource object.
+     * \param name Name shown by the containers.
+     */
+    void name_memory_resource(const void *resource, const string_t &name)
+    {
+        m_settings.memory_resource_names.insert_or_assign(resource, name);
+    }
+
+    // Streaming mode, writing the graph while the data is traversed.
+
+    /**
+     * Starts writing the graph to a sink: from now on, each node is written as a DOT line as soon as it is built, and
+     * each edge as soon as it is added. Instead of the nodes and edges, only the set of the visited node IDs is kept
+     * in memory, to avoid visiting a node twice.
+     * The graph header uses the cluster settings of the visualization at the time of this call.
+     * \param sink Stream to write to. Must stay alive until end_streaming is called.
+     * \param options Export options. Sequential node IDs are given in the order the nodes are first written, either
+     * as a node or as an edge end.
+     * \note The nodes and edges already in the visualization are not written.
+     */
+    void begin_streaming(std::basic_ostream<typename string_t::value_type> &sink,
+                         const dot_export_options &options = {})
+    {
+        m_stream_sink = &sink;
+        m_stream_node_id_writer = impl::node_id_writer<string_t>{options.node_ids};
+        m_stream_buffer.clear();
+        impl::append_graph_header_dot_string(m_stream_buffer, *this);
+        flush_stream_buffer();
+    }
+
+    /**
+     * Writes the rank constraints, closes the graph, and leaves the streaming mode.
+     */
+    void end_streaming()
+    {
+        if (m_stream_sink == nullptr)
+        {
+            return;
+        }
+        impl::append_graph_footer_dot_string(m_stream_buffer, m_rank_constraints, m_stream_node_id_writer);
+        flush_stream_buffer();
+        m_stream_sink = nullptr;
+        m_streamed_node_ids.clear();
+        m_stream_node_id_writer = impl::node_id_writer<string_t>{};
+    }
+
+    // Budgeted capture, spreading the traversal of a data structure over several calls.
+
+    /**
+     * Starts the capture of a data structure, which is then traversed by successive calls to step().
+     * Between two steps, the nodes that remain to be traversed are kept as references to the data. The data must
+     * therefore stay alive, and must not be modified, until the capture is complete.
+     * \param root Data structure to capture.
+     * \param version_probe Optional function returning the current version of the data (modification counter, epoch,
+     * etc.). It is called at each step; if the version changed since the beginning of the capture, the capture is
+     * abandoned. Without it, the data is assumed to be quiescent.
+     * \note Starting a capture abandons the previous one, if any.
+     * \note Growing the node and edge storage happens within a step. Call reserve beforehand to keep the steps of big
+     * captures within their budget.
+     */
+    template <typename data_t>
+    void begin_capture(const data_t &root, std::function<uint64_t()> version_probe = {})
+    {
+        m_pending_captures.clear();
+        m_pending_captures.emplace_back([this, &root] { traverse_data_structure(root); });
+        m_root_node_ids.emplace_back(impl::get_node_id_for_value(root));
+        m_capture_version_probe = std::move(version_probe);
+        m_capture_version = m_capture_version_probe ? m_capture_version_probe() : 0;
+    }
+
+    /**
+     * Traverses the data of the current capture until it is complete, or until the time budget is spent.
+     * One node (with its cells and outgoing edges) is the smallest unit of work: a step always builds at least one
+     * node, and does not start a node it does not expect to finish within the budget, based on the average node build
+     * time.
+     * \param time_budget Time this step may spend traversing the data.
+     * \return The state of the capture after this step.
+     */
+    capture_status step(const std::chrono::steady_clock::duration time_budget)
+    {
+        using clock = std::chrono::steady_clock;
+
+        if (m_pending_captures.empty())
+        {
+            return capture_status::complete;
+        }
+        if (m_capture_version_probe && m_capture_version_probe() != m_capture_version)
+        {
+            m_pending_captures.clear();
+            return capture_status::invalidated;
+        }
+
+        const auto deadline = clock::now() + time_budget;
+        m_is_capture_step_running = true;
+        auto now = clock::now();
+        do
+        {
+            auto pending_capture = std::move(m_pending_captures.back());
+            m_pending_captures.pop_back();
+            pending_capture();
+
+            // Children are pushed in reverse order, to traverse them in the same order as add_data_structure does.
+            m_pending_captures.insert(m_pending_captures.end(), std::make_move_iterator(m_deferred_captures.rbegin()),
+                                      std::make_move_iterator(m_deferred_captures.rend()));
+            m_deferred_captures.clear();
+
+            // Exponential moving average of the node build time.
+            const auto previous = now;
+            now = clock::now();
+            m_average_capture_duration = (3 * m_average_capture_duration + (now - previous)) / 4;
+        } while (!m_pending_captures.empty() && now + m_average_capture_duration < deadline);
+        m_is_capture_step_running = false;
+
+        return m_pending_captures.empty() ? capture_status::complete : capture_status::in_progress;
+    }
+
+    // Analyses of the captured graph.
+
+    /**
+     * Aggregates the memory footprints of the nodes per type, like the class histogram of a heap profiler.
+     * Only the nodes built by add_data_structure have a footprint.
+     * \return The memory used by each type, sorted by decreasing total bytes.
+     * \note In streaming mode the nodes are not kept, and do not appear here.
+     */
+    [[nodiscard]] std::vector<type_memory_usage> get_memory_usage_by_type() const
+    {
+        std::unordered_map<std::string_view, type_memory_usage> usages_by_type;
+        for (const auto &[node_id, node] : m_nodes)
+        {
+            const memory_footprint &footprint = node->get_memory_footprint();
+            if (footprint.type_name.empty())
+            {
+                continue;
+            }
+            type_memory_usage &usage = usages_by_type[footprint.type_name];
+            usage.type_name = footprint.type_name;
+            ++usage.instance_count;
+            usage.object_bytes += footprint.object_bytes;
+            if (m_embedded_node_ids.find(node_id) != m_embedded_node_ids.end())
+            {
+                usage.embedded_bytes += footprint.object_bytes;
+            }
+            usage.heap_bytes += footprint.heap_bytes;
+        }
+
+        std::vector<type_memory_usage> usages;
+        usages.reserve(usages_by_type.size());
+        for (const auto &[type_name, usage] : usages_by_type)
+        {
+            usages.emplace_back(usage);
+        }
+        std::sort(usages.begin(), usages.end(), [](const type_memory_usage &lhs, const type_memory_usage &rhs) {
+            if (lhs.get_total_bytes() != rhs.get_total_bytes())
+            {
+                return lhs.get_total_bytes() > rhs.get_total_bytes();
+            }
+            return lhs.type_name < rhs.type_name;
+        });
+        return usages;
+    }
+
+    /**
+     * \return The locality of the links followed by the traversal, per type of linked objects, by decreasing number of
+     * hops: between consecutive elements of std::list and std::forward_list, and from each pointer (raw pointers,
+     * std::unique_ptr) to the object it points to.
+     */
+    [[nodiscard]] std::vector<locality_metrics> get_locality_by_type() const
+    {
+        std::vector<locality_metrics> metrics;
+        metrics.reserve(m_locality_by_type.size());
+        for (const auto &[type_name, type_metrics] : m_locality_by_type)
+        {
+            metrics.emplace_back(type_metrics);
+        }
+        std::sort(metrics.begin(), metrics.end(), [](const locality_metrics &lhs, const locality_metrics &rhs) {
+            if (lhs.hop_count != rhs.hop_count)
+            {
+                return lhs.hop_count > rhs.hop_count;
+            }
+            return lhs.type_name < rhs.type_name;
+        });
+        return metrics;
+    }
+
+    /**
+     * Finds the objects sharing a cache line with an object of another data structure. When different threads write
+     * to them, the line bounces between the cores (false sharing). Objects stored inside one another, ie linked by
+     * composition edges, belong to the same data structure.
+     * \return IDs of the nodes of these objects, in node order.
+     */
+    [[nodiscard]] std::vector<uint64_t> find_false_sharing_candidates() const
+    {
+        constexpr uint64_t cache_line_bytes = locality_metrics::cache_line_bytes;
+
+        // Union-find of the nodes linked by composition edges: the representative identifies the data structure.
+        std::unordered_map<uint64_t, uint64_t> parent_node_ids;
+        const auto find_structure = [&parent_node_ids](uint64_t node_id) {
+            for (auto parent = parent_node_ids.find(node_id); parent != parent_node_ids.end();
+                 parent = parent_node_ids.find(node_id))
+            {
+                node_id = parent->second;
+            }
+            return node_id;
+        };
+        for (const arrow<string_t> &edge : m_directed_edges)
+        {
+            if (edge.style == edge_style::dashed && m_embedded_node_ids.count(edge.destination_node_id) != 0)
+            {
+                const uint64_t source_structure = find_structure(edge.source_node_id);
+                const uint64_t destination_structure = find_structure(edge.destination_node_id);
+                if (source_structure != destination_structure)
+                {
+                    parent_node_ids[destination_structure] = source_structure;
+                }
+            }
+        }
+
+        // Only the first and last lines of an object can be shared with objects it does not contain.
+        std::unordered_map<uint64_t, std::vector<std::pair<uint64_t, uint64_t>>> objects_by_line; // (structure, node)
+        for (const uint64_t node_id : m_node_order)
+        {
+            const size_t object_bytes = m_nodes.find(node_id)->second->get_memory_footprint().object_bytes;
+            if (object_bytes == 0)
+            {
+                continue;
+            }
+            const uint64_t structure = find_structure(node_id);
+            const uint64_t first_line = node_id / cache_line_bytes;
+            const uint64_t last_line = (node_id + object_bytes - 1) / cache_line_bytes;
+            objects_by_line[first_line].emplace_back(structure, node_id);
+            if (last_line != first_line)
+            {
+                objects_by_line[last_line].emplace_back(structure, node_id);
+            }
+        }
+
+        std::unordered_set<uint64_t> candidate_node_ids;
+        for (const auto &[line, objects] : objects_by_line)
+        {
+            const bool is_shared = std::any_of(objects.begin(), objects.end(), [&objects](const auto &object) {
+                return object.first != objects.front().first;
+            });
+            if (is_shared)
+            {
+                for (const auto &[structure, node_id] : objects)
+                {
+                    candidate_node_ids.insert(node_id);
+                }
+            }
+        }
+
+        std::vector<uint64_t> candidates;
+        std::copy_if(m_node_order.begin(), m_node_order.end(), std::back_inserter(candidates),
+                     [&candidate_node_ids](const uint64_t node_id) { return candidate_node_ids.count(node_id) != 0; });
+        return candidates;
+    }
+
+    /**
+     * \return The layouts of the adapted classes of the nodes, with their number of instances, by decreasing bytes lost
+     * in the holes of the layouts. Shows where reordering the members of a class saves the most memory.
+     */
+    [[nodiscard]] std::vector<class_layout_usage> get_class_layouts() const
+    {
+        std::unordered_map<const class_layout *, size_t> instance_counts_by_layout;
+        for (const auto &[node_id, node] : m_nodes)
+        {
+            if (const class_layout *layout = node->get_memory_footprint().layout)
+            {
+                ++instance_counts_by_layout[layout];
+            }
+        }
+
+        std::vector<class_layout_usage> usages;
+        usages.reserve(instance_counts_by_layout.size());
+        for (const auto &[layout, instance_count] : instance_counts_by_layout)
+        {
+            usages.push_back({layout, instance_count});
+        }
+        std::sort(usages.begin(), usages.end(), [](const class_layout_usage &lhs, const class_layout_usage &rhs) {
+            if (lhs.get_total_hole_bytes() != rhs.get_total_hole_bytes())
+            {
+                return lhs.get_total_hole_bytes() > rhs.get_total_hole_bytes();
+            }
+            return lhs.layout->type_name < rhs.layout->type_name;
+        });
+        return usages;
+    }
+
+    /**
+     * Builds the dominator tree of the nodes reachable from the roots, ie the data structures passed to
+     * add_data_structure and begin_capture, and computes the memory retained by each node: the memory that would be
+     * freed along with it. Unlike the memory reachable from a node, retained memory does not count the nodes shared
+     * with other parts of the graph.
+     * Runs in O(m log n) for n nodes and m edges.
+     * \note Shallow sizes are the ones of get_memory_usage_by_type: nodes added by hand have none.
+     */
+    [[nodiscard]] dominator_tree compute_dominator_tree() const
+    {
+        // Dense graph: vertex 0 is a virtual root leading to every root, vertex i + 1 is the node m_node_order[i].
+        std::unordered_map<uint64_t, uint32_t> vertices_by_node_id;
+        vertices_by_node_id.reserve(m_node_order.size());
+        for (size_t index = 0; index < m_node_order.size(); ++index)
+        {
+            vertices_by_node_id.emplace(m_node_order[index], static_cast<uint32_t>(index + 1));
+        }
+        const auto find_vertex = [&vertices_by_node_id](const uint64_t node_id) {
+            const auto found = vertices_by_node_id.find(node_id);
+            return found != vertices_by_node_id.end() ? found->second : uint32_t{0};
+        };
+
+        std::vector<std::pair<uint32_t, uint32_t>> edges;
+        edges.reserve(m_root_node_ids.size() + m_directed_edges.size());
+        for (const uint64_t root_node_id : m_root_node_ids)
+        {
+            if (const uint32_t root = find_vertex(root_node_id); root != 0)
+            {
+                edges.emplace_back(0, root);
+            }
+        }
+        for (const arrow<string_t> &edge : m_directed_edges)
+        {
+            const uint32_t source = find_vertex(edge.source_node_id);
+            const uint32_t destination = find_vertex(edge.destination_node_id);
+            if (source != 0 && destination != 0)
+            {
+                edges.emplace_back(source, destination);
+            }
+        }
+
+        // Compressed sparse rows, keeping the order of the edges.
+        std::vector<uint32_t> edge_offsets(m_node_order.size() + 2, 0);
+        for (const auto &[source, destination] : edges)
+        {
+            ++edge_offsets[source + 1];
+        }
+        std::partial_sum(edge_offsets.begin(), edge_offsets.end(), edge_offsets.begin());
+        std::vector<uint32_t> edge_targets(edges.size());
+        std::vector<uint32_t> edge_ends(edge_offsets.begin(), edge_offsets.end() - 1);
+        for (const auto &[source, destination] : edges)
+        {
+            edge_targets[edge_ends[source]++] = destination;
+        }
+        edges = {};
+
+        const impl::dominators dominators = impl::compute_dominators(edge_offsets, edge_targets, 0);
+
+        // The virtual root is left out of the tree.
+        dominator_tree tree;
+        const size_t node_count = dominators.preorder_vertices.size() - 1;
+        tree.node_ids.reserve(node_count);
+        tree.immediate_dominators.reserve(node_count);
+        tree.type_names.reserve(node_count);
+        tree.shallow_bytes.reserve(node_count);
+        for (size_t number = 1; number <= node_count; ++number)
+        {
+            const uint64_t node_id = m_node_order[dominators.preorder_vertices[number] - 1];
+            const memory_footprint &footprint = m_nodes.find(node_id)->second->get_memory_footprint();
+            const bool is_embedded = m_embedded_node_ids.find(node_id) != m_embedded_node_ids.end();
+            const uint32_t immediate_dominator = dominators.immediate_dominators[number];
+
+            tree.node_ids.push_back(node_id);
+            tree.immediate_dominators.push_back(immediate_dominator == 0 ? dominator_tree::no_dominator
+                                                                         : immediate_dominator - 1);
+            tree.type_names.push_back(footprint.type_name);
+            tree.shallow_bytes.push_back((is_embedded ? 0 : footprint.object_bytes) + footprint.heap_bytes);
+        }
+
+        // Dominators come first in preorder: a reverse traversal accumulates the retained bytes bottom-up.
+        tree.retained_bytes = tree.shallow_bytes;
+        for (size_t position = node_count; position-- > 0;)
+        {
+            if (tree.immediate_dominators[position] != dominator_tree::no_dominator)
+            {
+                tree.retained_bytes[tree.immediate_dominators[position]] += tree.retained_bytes[position];
+            }
+        }
+        return tree;
+    }
+
+    /**
+     * Finds the cycles of owning references that go through shared pointers. The objects of such a cycle keep each
+     * other alive: they leak as soon as the rest of the program stops referencing them. Composition edges,
+     * std::unique_ptr and std::shared_ptr own the object they point to; raw pointers and std::weak_ptr do not, and
+     * break the cycles.
+     * Runs in O(n + m) for n nodes and m edges, plus the edges of the nodes retained by the cycles.
+     * \return The cycles, by decreasing retained bytes.
+     * \note Shallow sizes are the ones of get_memory_usage_by_type: nodes added by hand have none.
+     */
+    [[nodiscard]] std::vector<reference_cycle> find_reference_cycles() const
+    {
+        // Dense graph of the owning edges: vertex i is the node m_node_order[i].
+        constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+        const auto vertex_count = static_cast<uint32_t>(m_node_order.size());
+        std::unordered_map<uint64_t, uint32_t> vertices_by_node_id;
+        vertices_by_node_id.reserve(vertex_count);
+        for (uint32_t vertex = 0; vertex < vertex_count; ++vertex)
+        {
+            vertices_by_node_id.emplace(m_node_order[vertex], vertex);
+        }
+
+        // Self-loops are left out: composition ones come from a class and its first member sharing their node ID.
+        std::vector<std::pair<uint32_t, uint32_t>> edges;
+        std::vector<std::pair<uint32_t, uint32_t>> shared_edges;
+        for (const arrow<string_t> &edge : m_directed_edges)
+        {
+            const bool is_composition =
+                edge.style == edge_style::dashed && m_embedded_node_ids.count(edge.destination_node_id) != 0;
+            if (!is_composition && edge.ownership != pointer_ownership::exclusive &&
+                edge.ownership != pointer_ownership::shared)
+            {
+                continue;
+            }
+            const auto source = vertices_by_node_id.find(edge.source_node_id);
+            const auto destination = vertices_by_node_id.find(edge.destination_node_id);
+            if (source == vertices_by_node_id.end() || destination == vertices_by_node_id.end())
+            {
+                continue;
+            }
+            if (source->second != destination->second)
+            {
+                edges.emplace_back(source->second, destination->second);
+            }
+            if (edge.ownership == pointer_ownership::shared)
+            {
+                shared_edges.emplace_back(source->second, destination->second);
+            }
+        }
+
+        // Compressed sparse rows, and number of owners of each vertex.
+        std::vector<uint32_t> edge_offsets(vertex_count + 1, 0);
+        std::vector<uint32_t> owner_counts(vertex_count, 0);
+        for (const auto &[source, destination] : edges)
+        {
+            ++edge_offsets[source + 1];
+            ++owner_counts[destination];
+        }
+        std::partial_sum(edge_offsets.begin(), edge_offsets.end(), edge_offsets.begin());
+        std::vector<uint32_t> edge_targets(edges.size());
+        std::vector<uint32_t> edge_ends(edge_offsets.begin(), edge_offsets.end() - 1);
+        for (const auto &[source, destination] : edges)
+        {
+            edge_targets[edge_ends[source]++] = destination;
+        }
+        edges = {};
+
+        // Components of owning edges containing a shared pointer edge are cycles.
+        const impl::strongly_connected_components components =
+            impl::find_strongly_connected_components(edge_offsets, edge_targets);
+        std::vector<uint32_t> cycle_indices(components.component_count, none);
+        std::vector<reference_cycle> cycles;
+        for (const auto &[source, destination] : shared_edges)
+        {
+            const uint32_t component = components.vertex_components[source];
+            if (component == components.vertex_components[destination] && cycle_indices[component] == none)
+            {
+                cycle_indices[component] = static_cast<uint32_t>(cycles.size());
+                cycles.emplace_back();
+            }
+        }
+
+        const auto get_shallow_bytes = [this](const uint64_t node_id) {
+            const memory_footprint &footprint = m_nodes.find(node_id)->second->get_memory_footprint();
+            const bool is_embedded = m_embedded_node_ids.find(node_id) != m_embedded_node_ids.end();
+            return (is_embedded ? 0 : footprint.object_bytes) + footprint.heap_bytes;
+        };
+        std::vector<std::vector<uint32_t>> cycle_vertices(cycles.size());
+        for (uint32_t vertex = 0; vertex < vertex_count; ++vertex)
+        {
+            if (const uint32_t cycle_index = cycle_indices[components.vertex_components[vertex]]; cycle_index != none)
+            {
+                const uint64_t node_id = m_node_order[vertex];
+                reference_cycle &cycle = cycles[cycle_index];
+                cycle.node_ids.push_back(node_id);
+                cycle.type_names.push_back(m_nodes.find(node_id)->second->get_memory_footprint().type_name);
+                cycle.cycle_bytes += get_shallow_bytes(node_id);
+                cycle_vertices[cycle_index].push_back(vertex);
+            }
+        }
+
+        // A node is retained by a cycle once all its owners are: its own, or retained by it.
+        std::vector<uint32_t> retaining_cycles(vertex_count, none);
+        std::vector<uint32_t> retained_owner_counts(vertex_count, 0);
+        for (uint32_t cycle_index = 0; cycle_index < cycles.size(); ++cycle_index)
+        {
+            std::vector<uint32_t> &retained_vertices = cycle_vertices[cycle_index];
+            for (const uint32_t vertex : retained_vertices)
+            {
+                retaining_cycles[vertex] = cycle_index;
+            }
+            std::vector<uint32_t> counted_vertices;
+            size_t retained_bytes = cycles[cycle_index].cycle_bytes;
+            for (size_t position = 0; position < retained_vertices.size(); ++position)
+            {
+                const uint32_t vertex = retained_vertices[position];
+                for (uint32_t edge = edge_offsets[vertex]; edge < edge_offsets[vertex + 1]; ++edge)
+                {
+                    const uint32_t target = edge_targets[edge];
+                    if (retaining_cycles[target] == cycle_index)
+                    {
+                        continue;
+                    }
+                    counted_vertices.push_back(target);
+                    if (++retained_owner_counts[target] == owner_counts[target])
+                    {
+                        retaining_cycles[target] = cycle_index;
+                        retained_vertices.push_back(target);
+                        retained_bytes += get_shallow_bytes(m_node_order[target]);
+                    }
+                }
+            }
+            for (const uint32_t vertex : counted_vertices)
+            {
+                retained_owner_counts[vertex] = 0;
+            }
+            cycles[cycle_index].retained_bytes = retained_bytes;
+        }
+
+        std::stable_sort(cycles.begin(), cycles.end(), [](const reference_cycle &lhs, const reference_cycle &rhs) {
+            return lhs.retained_bytes > rhs.retained_bytes;
+        });
+        return cycles;
+    }
+
+    // Advanced automatic data structure visualization functions.
+
+    /**
+     * Adds a node for the data structure, and for all the data that can be reached from it. The data structure is a
+     * root of the graph (see compute_dominator_tree).
+     * \return The ID of the data structure's node.
+     */
+    template <typename data_t>
+    uint64_t add_data_structure(const data_t &data_structure)
+    {
+        const uint64_t node_id = traverse_data_structure(data_structure);
+        m_root_node_ids.emplace_back(node_id);
+        return node_id;
+    }
+
+    /**
+     * Adds a node for the elements of an ordered map (std::map, std::multimap) whose keys are between first_key and
+     * last_key, and for all the data that can be reached from them. The slice is found in logarithmic time: the other
+     * elements are never visited. The map is a root of the graph.
+     * \return The ID of the map's node.
+     * \note The node stands for the map: if the map is added again, or reached from other data, the slice is kept.
+     */
+    template <typename ordered_map_t>
+    uint64_t add_map_slice(const ordered_map_t &map, const typename ordered_map_t::key_type &first_key,
+                           const typename ordered_map_t::key_type &last_key)
+    {
+        static_assert(impl::is_ordered_map_v<ordered_map_t>, "Only ordered maps can be sliced by key.");
+
+        string_t slice_str{lit(string_t, "Slice")};
+        if constexpr (impl::is_simple_type_v<typename ordered_map_t::key_type>)
+        {
+            slice_str += lit(string_t, ": ");
+            slice_str += cdv::to_string<string_t>(first_key);
+            slice_str += lit(string_t, " to ");
+            slice_str += cdv::to_string<string_t>(last_key);
+        }
+        const uint64_t node_id = add_key_value_container(map, map.lower_bound(first_key), map.upper_bound(last_key),
+                                                         std::move(slice_str));
+        m_root_node_ids.emplace_back(node_id);
+        return node_id;
+    }
+
+    /**
+     * Adds a node for the rows [first_index, last_index) of a struct-of-arrays class (see CDV_ADAPT_COLUMNS), and for
+     * all the data that can be reached from them. The class is a root of the graph.
+     * \param column_names Names of the displayed columns. All the columns are displayed if empty.
+     * \return The ID of the class's node.
+     * \note The node stands for the instance: if it is added again, or reached from other data, the slice is kept.
+     */
+    template <typename columnar_class_t>
+    uint64_t add_columns_slice(const columnar_class_t &instance, const size_t first_index, const size_t last_index,
+                               const std::vector<std::string_view> &column_names = {})
+    {
+        static_assert(traits::is_columnar_v<columnar_class_t>, "The class must be declared with CDV_ADAPT_COLUMNS.");
+
+        const uint64_t node_id = add_columnar_class(instance, first_index, last_index, column_names);
+        m_root_node_ids.emplace_back(node_id);
+        return node_id;
+    }
+
+  private:
+    // Adds a node for the data structure and for all the data that can be reached from it, without making it a root.
+    template <typename data_t>
+    uint64_t traverse_data_structure(const data_t &data_structure)
+    {
+        // For the null pointer type.
+        if constexpr (std::is_null_pointer_v<data_t>)
+        {
+            return add_null_pointer();
+        }
+        else if constexpr (impl::is_cstring_type_v<data_t>)
+        {
+            return add_cstring(data_structure);
+        }
+        else if constexpr (std::is_pointer_v<data_t>)
+        {
+            return add_pointer(data_structure);
+        }
+        else if constexpr (traits::is_linear_container_v<data_t>)
+        {
+            return add_linear_container(data_structure);
+        }
+        else if constexpr (traits::is_key_value_container_v<data_t>)
+        {
+            if constexpr (impl::is_hash_table_v<data_t>)
+            {
+                if (m_settings.is_hash_table_health_enabled)
+                {
+                    return add_hash_table(data_structure);
+                }
+            }
+            return add_key_value_container(data_structure, std::cbegin(data_structure), std::cend(data_structure));
+        }
+        else if constexpr (traits::is_columnar_v<data_t>)
+        {
+            return add_columnar_class(data_structure, 0, std::numeric_limits<size_t>::max(), {});
+        }
+        else if constexpr (traits::is_adapted_v<data_t>)
+        {
+            return add_adapted_class(data_structure);
+        }
+        else if constexpr (impl::is_simple_type_v<data_t>)
+        {
+            return add_simple_value(data_structure);
+        }
+        else
+        {
+            static_assert(impl::always_false_v<data_t>,
+                          "cdv cannot browse this type: adapt it (see CDV_ADAPT_CLASS), or declare its traits.");
+            return impl::nullptr_pointer_node_id;
+        }
+    }
+
+    // For known linear containers, ie containers that contain values that can be iterated over,
+    // as opposed to key-value containers that also contain keys.
+    template <typename linear_container_t>
+    uint64_t add_linear_container(const linear_container_t &container)
+    {
+        using value_t = typename linear_container_t::value_type;
+
+        // |--------------------------------------------|
+        // | <Type name> | <Address> | Length: <Length> |
+        // |--------------------------------------------|
+        // | <Val 1> | <Val 2> | <Val 3> | ............ |
+        // |--------------------------------------------|
+
+        const uint64_t container_node_id = impl::get_node_id_for_value(container);
+        if (has_node(container_node_id))
+        {
+            return container_node_id;
+        }
+
+        auto type_name = impl::get_type_name_string<linear_container_t, string_t>();
+        auto instance_address = impl::get_address_as_string<string_t>(impl::get_identifying_address(container));
+        // Use std::distance, because some containers don't have a size (std::forward_list is one).
+        const auto length = std::distance(std::cbegin(container), std::cend(container));
+        auto length_str = string_t{lit(string_t, "Length: ")} + to_string<string_t>(length);
+        auto header_row = typename table_node<string_t>::row{};
+        header_row.cells.emplace_back(cell_t{std::move(type_name)}.spanning_columns(4));
+        header_row.cells.emplace_back(cell_t{std::move(instance_address)}.spanning_columns(2));
+        header_row.cells.emplace_back(cell_t{std::move(length_str)}.spanning_columns(2));
+        if (m_settings.is_capacity_reporting_enabled)
+        {
+            add_capacity_cells(container, static_cast<size_t>(length), header_row);
+        }
+        add_memory_resource_cell(container, header_row);
+        auto container_node = table_node<string_t>{}.with_row(std::move(header_row));
+        container_node.set_memory_footprint(impl::make_memory_footprint(container));
+        if constexpr (impl::get_element_link_bytes<linear_container_t>() != 0)
+        {
+            record_element_hops(container);
+        }
+
+        constexpr member_display_type data_display_type = impl::get_data_display_type<value_t>();
+
+        const member_display_type values_display_type = get_values_display_type<value_t>(static_cast<size_t>(length));
+        // Summarize the values.
+        if (values_display_type == member_display_type::statistics)
+        {
+            add_numeric_summary_rows(container, container_node);
+        }
+        // Draw the rows as a matrix.
+        else if (values_display_type == member_display_type::matrix)
+        {
+            add_matrix_rows(container, static_cast<size_t>(length), container_node);
+        }
+        // Put the value directly in each cell.
+        else if constexpr (data_display_type == member_display_type::inside)
+        {
+            auto values_row = typename table_node<string_t>::row{};
+            values_row.cells.emplace_back(lit(string_t, "Values: "));
+            if constexpr (impl::has_bulk_formatting_v<value_t> && impl::has_contiguous_data<linear_container_t>::value)
+            {
+                impl::append_bulk_values(values_row.bulk_values, values_row.bulk_value_ends, std::data(container),
+                                         std::size(container));
+            }
+            else
+            {
+                size_t elements_heap_bytes = 0;
+                for (const auto &value : container)
+                {
+                    values_row.cells.emplace_back(cdv::to_string<string_t>(value));
+                    elements_heap_bytes += impl::get_owned_heap_bytes(value);
+                }
+                container_node.add_owned_heap_bytes(elements_heap_bytes);
+            }
+            container_node.add_row(std::move(values_row));
+        }
+        // value_t is a pointer type:
+        // - put the ADDRESS in each cell,
+        // - add a node for each pointed value,
+        // - add an edge to each node
+        else if constexpr (data_display_type == member_display_type::pointer_edge)
+        {
+            auto values_row = typename table_node<string_t>::row{};
+            values_row.cells.emplace_back(lit(string_t, "Values: "));
+            if (should_traverse_in_parallel<linear_container_t>(length))
+            {
+                add_elements_in_parallel<data_display_type>(container, container_node_id, values_row);
+            }
+            else
+            {
+                size_t index = 0;
+                for (const auto &value : container)
+                {
+                    add_element_cell_and_edge<data_display_type>(
+                        value, index, container_node_id,
+                        value != nullptr ? add_child_data_structure(*value) : impl::nullptr_pointer_node_id,
+                        values_row);
+                    ++index;
+                }
+            }
+            container_node.add_row(values_row);
+        }
+        // value_t is an adapted type:
+        // - put the INDEX in each cell,
+        // - add a node for each value,
+        // - add an edge to each node
+        else if constexpr (data_display_type == member_display_type::composition_edge)
+        {
+            auto values_row = typename table_node<string_t>::row{};
+            values_row.cells.emplace_back(lit(string_t, "Values: "));
+            if (should_traverse_in_parallel<linear_container_t>(length))
+            {
+                add_elements_in_parallel<data_display_type>(container, container_node_id, values_row);
+            }
+            else
+            {
+                size_t index = 0;
+                for (const auto &value : container)
+                {
+                    add_element_cell_and_edge<data_display_type>(value, index, container_node_id,
+                                                                 add_child_data_structure(value), values_row);
+                    ++index;
+                }
+            }
+            container_node.add_row(values_row);
+        }
+
+        // todo std::reference_wrapper
+
+        add_node(container_node_id, std::move(container_node));
+        return container_node_id;
+    }
+
+    // For key-value containers (std::map, std::unordered_map, etc.), or the slice [first, last) of their elements.
+    template <typename key_value_container_t, typename iterator_t>
+    uint64_t add_key_value_container(const key_value_container_t &container, iterator_t first, const iterator_t last,
+                                     string_t slice_str = {})
+    {
+        // |----------------------------------------------------------------------|
+        // | <Type name> | <Address> | Size: <Size> | <Slice> | Shown: <Count>    |
+        // |----------------------------------------------------------------------|
+        // | Keys:   | <Key 1>   | <Key 2>   | <Key 3>   | ...................... |
+        // | Values: | <Value 1> | <Value 2> | <Value 3> | ...................... |
+        // |----------------------------------------------------------------------|
+
+        const uint64_t container_node_id = impl::get_node_id_for_value(container);
+        if (has_node(container_node_id))
+        {
+            return container_node_id;
+        }
+
+        // Use std::distance, because some containers don't have a size (std::forward_list is one).
+        const auto size = static_cast<size_t>(std::distance(std::cbegin(container), std::cend(container)));
+        const auto element_count = slice_str.empty() ? size : static_cast<size_t>(std::distance(first, last));
+        const size_t max_displayed_element_count = m_settings.max_displayed_key_value_elements;
+        const size_t displayed_element_count =
+            max_displayed_element_count == 0 ? element_count : std::min(element_count, max_displayed_element_count);
+
+        auto header_row = typename table_node<string_t>::row{};
+        header_row.cells.emplace_back(
+            cell_t{impl::get_type_name_string<key_value_container_t, string_t>()}.spanning_columns(4));
+        header_row.cells.emplace_back(cell_t{impl::get_address_as_string<string_t>(&container)}.spanning_columns(2));
+        header_row.cells.emplace_back(
+            cell_t{string_t{lit(string_t, "Size: ")} + to_string<string_t>(size)}.spanning_columns(2));
+        if (!slice_str.empty())
+        {
+            slice_str += lit(string_t, " (");
+            slice_str += to_string<string_t>(element_count);
+            slice_str += lit(string_t, " elements)");
+            header_row.cells.emplace_back(cell_t{std::move(slice_str)}.spanning_columns(2));
+        }
+        if (displayed_element_count != element_count)
+        {
+            header_row.cells.emplace_back(
+                cell_t{string_t{lit(string_t, "Shown: ")} + to_string<string_t>(displayed_element_count)}
+                    .spanning_columns(2));
+        }
+        add_memory_resource_cell(container, header_row);
+        auto container_node = table_node<string_t>{}.with_row(std::move(header_row));
+        container_node.set_memory_footprint(impl::make_memory_footprint(container));
+
+        auto keys_row = typename table_node<string_t>::row{};
+        auto values_row = typename table_node<string_t>::row{};
+        keys_row.cells.emplace_back(lit(string_t, "Keys: "));
+        values_row.cells.emplace_back(lit(string_t, "Values: "));
+        size_t elements_heap_bytes = 0;
+        for (size_t index = 0; index < displayed_element_count; ++index, ++first)
+        {
+            const auto index_str = cdv::to_string<string_t>(index);
+            add_key_value_cell(first->first, index_str, string_t{lit(string_t, "k")} + index_str, container_node_id,
+                               keys_row, elements_heap_bytes);
+            add_key_value_cell(first->second, index_str, index_str, container_node_id, values_row,
+                               elements_heap_bytes);
+        }
+        container_node.add_row(std::move(keys_row));
+        container_node.add_row(std::move(values_row));
+        container_node.add_owned_heap_bytes(elements_heap_bytes);
+
+        add_node(container_node_id, std::move(container_node));
+        return container_node_id;
+    }
+
+    // Adds the cell of a key or a value of a key-value container. Numbers are formatted in bulk into the row.
+    template <typename data_t>
+    void add_key_value_cell(const data_t &data, const string_t &index_str, const string_t &port_name,
+                            const uint64_t container_node_id, typename table_node<string_t>::row &row,
+                            size_t &elements_heap_bytes)
+    {
+        if constexpr (impl::get_data_display_type<data_t>() == member_display_type::inside &&
+                      impl::has_bulk_formatting_v<data_t>)
+        {
+            impl::append_bulk_value(row.bulk_values, row.bulk_value_ends, data);
+        }
+        else
+        {
+            row.cells.emplace_back(
+                make_element_cell(data, index_str, port_name, container_node_id, elements_heap_bytes));
+        }
+    }
+
+    // Makes the cell of an element stored in a node, following the same rules as the elements of linear containers.
+    // Elements displayed as separate nodes get an edge from the cell to their node.
+    template <typename data_t>
+    cell_t make_element_cell(const data_t &data, const string_t &index_str, const string_t &port_name,
+                             const uint64_t container_node_id, size_t &elements_heap_bytes)
+    {
+        constexpr member_display_type data_display_type = impl::get_data_display_type<data_t>();
+
+        // The value itself in the cell.
+        if constexpr (data_display_type == member_display_type::inside)
+        {
+            elements_heap_bytes += impl::get_owned_heap_bytes(data);
+            return cell_t{cdv::to_string<string_t>(data)};
+        }
+        // Pointer: the ADDRESS in the cell, and a pointer edge (if not null).
+        else if constexpr (data_display_type == member_display_type::pointer_edge)
+        {
+            if (data != nullptr)
+            {
+                record_pointer_hop(&data, data);
+                add_edge(
+                    arrow<string_t>{container_node_id, port_name, add_child_data_structure(*data), lit(string_t, "")});
+            }
+            return cell_t{impl::get_address_as_string<string_t>(data)}.with_port(port_name);
+        }
+        // Otherwise: the INDEX in the cell, and a composition edge.
+        else
+        {
+            const uint64_t element_node_id = add_child_data_structure(data);
+            mark_embedded_node(element_node_id);
+            add_edge(arrow<string_t>{container_node_id, port_name, element_node_id, lit(string_t, "")}.with_style(
+                edge_style::dashed));
+            return cell_t{index_str}.with_port(port_name);
+        }
+    }
+
+    // For struct-of-arrays classes (see CDV_ADAPT_COLUMNS): one table with a row per index, for the rows
+    // [first_index, last_index) and the given columns (all of them if empty).
+    template <typename columnar_class_t>
+    uint64_t add_columnar_class(const columnar_class_t &instance, const size_t first_index, size_t last_index,
+                                const std::vector<std::string_view> &column_names)
+    {
+        // |--------------------------------------------------------------------|
+        // | <Type name> | <Address> | Rows: <Count> | Slice: [<First>, <Last>) |
+        // |--------------------------------------------------------------------|
+        // | Index       | <Column 1> | <Column 2> | .......................... |
+        // | <Index 1>   | <Value 1>  | <Value 1>  | .......................... |
+        // | .................................................................. |
+        // |--------------------------------------------------------------------|
+
+        const uint64_t instance_node_id = impl::get_node_id_for_value(instance);
+        if (has_node(instance_node_id))
+        {
+            return instance_node_id;
+        }
+
+        const auto column_table = traits::columns<columnar_class_t>::get();
+        auto instance_node = table_node<string_t>{};
+        instance_node.set_memory_footprint(impl::make_memory_footprint(instance));
+
+        // The columns are owned by the instance: their buffers count in its heap bytes.
+        size_t min_length = std::numeric_limits<size_t>::max();
+        size_t max_length = 0;
+        size_t columns_heap_bytes = 0;
+        impl::for_each_member_descriptor(column_table, [&](const auto &column_descriptor) {
+            const auto &column = column_descriptor.get_member_value(instance);
+            const auto length = static_cast<size_t>(std::distance(std::cbegin(column), std::cend(column)));
+            min_length = std::min(min_length, length);
+            max_length = std::max(max_length, length);
+            columns_heap_bytes += impl::get_owned_heap_bytes(column);
+        });
+        const size_t row_count = std::min(min_length, max_length);
+        const bool is_slice = first_index != 0 || last_index < row_count || !column_names.empty();
+        last_index = std::max(first_index, std::min(last_index, row_count));
+
+        auto header_row = typename table_node<string_t>::row{};
+        header_row.cells.emplace_back(impl::get_type_name_string<columnar_class_t, string_t>());
+        header_row.cells.emplace_back(impl::get_address_as_string<string_t>(&instance));
+        header_row.cells.emplace_back(string_t{lit(string_t, "Rows: ")} + to_string<string_t>(row_count));
+        if (is_slice)
+        {
+            header_row.cells.emplace_back(string_t{lit(string_t, "Slice: [")} + to_string<string_t>(first_index) +
+                                          lit(string_t, ", ") + to_string<string_t>(last_index) + lit(string_t, ")"));
+        }
+        // Columns of different lengths: only the rows present in all of them are displayed.
+        if (min_length != max_length)
+        {
+            header_row.cells.emplace_back(
+                cell_t{string_t{lit(string_t, "Column lengths: ")} + to_string<string_t>(min_length) +
+                       lit(string_t, " to ") + to_string<string_t>(max_length)}
+                    .with_background_color(string_t{lit(string_t, "#ff9f9f")}));
+        }
+        instance_node.add_row(std::move(header_row));
+
+        // Each column is read contiguously into its own cells, which are then interleaved into the rows.
+        auto names_row = typename table_node<string_t>::row{};
+        names_row.cells.emplace_back(lit(string_t, "Index"));
+        std::vector<std::vector<cell_t>> column_cells;
+        size_t elements_heap_bytes = 0;
+        size_t column_index = 0;
+        impl::for_each_member_descriptor(column_table, [&](const auto &column_descriptor) {
+            const std::string_view column_name{column_descriptor.get_member_name()};
+            if (column_names.empty() ||
+                std::find(column_names.begin(), column_names.end(), column_name) != column_names.end())
+            {
+                names_row.cells.emplace_back(cdv::to_string<string_t>(column_descriptor.get_member_name()));
+                const string_t port_prefix = cdv::to_string<string_t>(column_index) + lit(string_t, "_");
+                auto &cells = column_cells.emplace_back();
+                cells.reserve(last_index - first_index);
+
+                const auto &column = column_descriptor.get_member_value(instance);
+                auto element = std::next(std::cbegin(column), static_cast<std::ptrdiff_t>(first_index));
+                for (size_t index = first_index; index < last_index; ++index, ++element)
+                {
+                    const auto index_str = cdv::to_string<string_t>(index);
+                    cells.emplace_back(
+                        make_element_cell(*element, index_str, port_prefix + index_str, instance_node_id,
+                                          elements_heap_bytes));
+                }
+            }
+            ++column_index;
+        });
+        instance_node.add_row(std::move(names_row));
+
+        for (size_t index = first_index; index < last_index; ++index)
+        {
+            auto row = typename table_node<string_t>::row{};
+            row.cells.reserve(column_cells.size() + 1);
+            row.cells.emplace_back(cdv::to_string<string_t>(index));
+            for (auto &cells : column_cells)
+            {
+                row.cells.emplace_back(std::move(cells[index - first_index]));
+            }
+            instance_node.add_row(std::move(row));
+        }
+        instance_node.add_owned_heap_bytes(columns_heap_bytes + elements_heap_bytes);
+
+        add_node(instance_node_id, std::move(instance_node));
+        return instance_node_id;
+    }
+
+    // For hash tables (std::unordered_map, std::unordered_multimap): shows the health of the buckets rather than the
+    // elements, to make bad hash functions visible. See set_hash_table_health.
+    template <typename hash_table_t>
+    uint64_t add_hash_table(const hash_table_t &hash_table)
+    {
+        using key_t = typename hash_table_t::key_type;
+
+        // |----------------------------------------------------------------------------------------|
+        // | <Type name> | <Address> | Size: <Size>                                                 |
+        // |----------------------------------------------------------------------------------------|
+        // | Buckets: <Count> | Load factor: <Load> | Max load factor: <Max> | Longest chain: <Max> |
+        // |----------------------------------------------------------------------------------------|
+        // | Elements per bucket: | 0       | 1       | ... | 8+      |
+        // | Buckets:             | <Count> | <Count> | ... | <Count> |
+        // |----------------------------------------------------------------------------------------|
+        // | Bucket <Index>       | <Size> elements | <Key 1> | <Key 2> | ... |  <- worst buckets
+        // |----------------------------------------------------------------------------------------|
+
+        const uint64_t node_id = impl::get_node_id_for_value(hash_table);
+        if (has_node(node_id))
+        {
+            return node_id;
+        }
+
+        // Buckets of 8 elements or more share the last bin of the histogram.
+        constexpr size_t histogram_bin_count = 9;
+        constexpr size_t worst_bucket_count = 3;
+        constexpr size_t keys_per_worst_bucket = 8;
+
+        // One pass over the buckets. The worst buckets are kept sorted by decreasing size, then by index.
+        const size_t bucket_count = hash_table.bucket_count();
+        std::vector<size_t> occupancy_histogram(histogram_bin_count, 0);
+        std::vector<std::pair<size_t, size_t>> worst_buckets; // (size, index)
+        worst_buckets.reserve(worst_bucket_count + 1);
+        for (size_t bucket = 0; bucket < bucket_count; ++bucket)
+        {
+            const size_t bucket_size = hash_table.bucket_size(bucket);
+            ++occupancy_histogram[std::min(bucket_size, histogram_bin_count - 1)];
+            // Only buckets with collisions are worth showing.
+            if (bucket_size >= 2 &&
+                (worst_buckets.size() < worst_bucket_count || bucket_size > worst_buckets.back().first))
+            {
+                const auto position =
+                    std::find_if(worst_buckets.begin(), worst_buckets.end(),
+                                 [bucket_size](const auto &worst) { return worst.first < bucket_size; });
+                worst_buckets.insert(position, {bucket_size, bucket});
+                if (worst_buckets.size() > worst_bucket_count)
+                {
+                    worst_buckets.pop_back();
+                }
+            }
+        }
+        const size_t longest_chain = worst_buckets.empty() ? (hash_table.empty() ? 0 : 1) : worst_buckets.front().first;
+
+        auto header_row = typename table_node<string_t>::row{};
+        header_row.cells.emplace_back(cell_t{impl::get_type_name_string<hash_table_t, string_t>()}.spanning_columns(2));
+        header_row.cells.emplace_back(impl::get_address_as_string<string_t>(&hash_table));
+        header_row.cells.emplace_back(string_t{lit(string_t, "Size: ")} + to_string<string_t>(hash_table.size()));
+        add_memory_resource_cell(hash_table, header_row);
+        auto hash_table_node = table_node<string_t>{}.with_row(std::move(header_row));
+        hash_table_node.add_row(
+            string_t{lit(string_t, "Buckets: ")} + to_string<string_t>(bucket_count),
+            string_t{lit(string_t, "Load factor: ")} + to_string<string_t>(hash_table.load_factor()),
+            string_t{lit(string_t, "Max load factor: ")} + to_string<string_t>(hash_table.max_load_factor()),
+            string_t{lit(string_t, "Longest chain: ")} + to_string<string_t>(longest_chain));
+
+        auto histogram_bins_row = typename table_node<string_t>::row{};
+        auto histogram_counts_row = typename table_node<string_t>::row{};
+        histogram_bins_row.cells.emplace_back(lit(string_t, "Elements per bucket: "));
+        histogram_counts_row.cells.emplace_back(lit(string_t, "Buckets: "));
+        for (size_t bin = 0; bin < histogram_bin_count; ++bin)
+        {
+            histogram_bins_row.cells.emplace_back(bin + 1 < histogram_bin_count
+                                                      ? to_string<string_t>(bin)
+                                                      : to_string<string_t>(bin) + lit(string_t, "+"));
+            histogram_counts_row.cells.emplace_back(to_string<string_t>(occupancy_histogram[bin]));
+        }
+        hash_table_node.add_row(std::move(histogram_bins_row));
+        hash_table_node.add_row(std::move(histogram_counts_row));
+
+        for (const auto &[bucket_size, bucket] : worst_buckets)
+        {
+            auto bucket_row = typename table_node<string_t>::row{};
+            bucket_row.cells.emplace_back(string_t{lit(string_t, "Bucket ")} + to_string<string_t>(bucket));
+            bucket_row.cells.emplace_back(to_string<string_t>(bucket_size) + lit(string_t, " elements"));
+            size_t key_count = 0;
+            for (auto element = hash_table.cbegin(bucket); element != hash_table.cend(bucket); ++element)
+            {
+                if (key_count++ == keys_per_worst_bucket)
+                {
+                    bucket_row.cells.emplace_back(lit(string_t, "..."));
+                    break;
+                }
+                if constexpr (impl::is_simple_type_v<key_t>)
+                {
+                    bucket_row.cells.emplace_back(cdv::to_string<string_t>(element->first));
+                }
+                else
+                {
+                    bucket_row.cells.emplace_back(impl::get_address_as_string<string_t>(&element->first));
+                }
+            }
+            hash_table_node.add_row(std::move(bucket_row));
+        }
+
+        hash_table_node.set_memory_footprint(impl::make_memory_footprint(hash_table));
+        add_node(node_id, std::move(hash_table_node));
+        return node_id;
+    }
+
+    // 'statistics' for the values of the containers of numbers long enough to be summarized, see set_numeric_summary.
+    // 'matrix' for the rows of numbers, see set_matrix_display. Otherwise, the display type of their elements.
+    template <typename value_t>
+    [[nodiscard]] member_display_type get_values_display_type(const size_t length) const
+    {
+        if constexpr (impl::is_summarizable_number_v<value_t>)
+        {
+            if (m_settings.numeric_summary_min_length != 0 && length >= m_settings.numeric_summary_min_length)
+            {
+                return member_display_type::statistics;
+            }
+        }
+        else if constexpr (impl::is_matrix_row_v<value_t>)
+        {
+            if (m_settings.matrix_grid_size != 0)
+            {
+                return member_display_type::matrix;
+            }
+        }
+        return impl::get_data_display_type<value_t>();
+    }
+
+    template <typename linear_container_t>
+    void add_numeric_summary_rows(const linear_container_t &container, table_node<string_t> &container_node) const
+    {
+        // | Values: | Min: <Min> | Max: <Max> | Mean: <Mean> | Std dev: <Std dev> | NaN: <Count> | Inf: <Count> |
+        // | From:   | <Bin 1 start> | <Bin 2 start> | ... |
+        // | Count:  | <Bin 1 count> | <Bin 2 count> | ... |
+        if constexpr (impl::is_summarizable_number_v<typename linear_container_t::value_type>)
+        {
+            impl::numeric_statistics statistics;
+            if constexpr (impl::has_contiguous_data<linear_container_t>::value)
+            {
+                const auto *data = std::data(container);
+                statistics = impl::compute_numeric_statistics(data, data + std::size(container),
+                                                              m_settings.numeric_summary_bin_count);
+            }
+            else
+            {
+                statistics = impl::compute_numeric_statistics(container.cbegin(), container.cend(),
+                                                              m_settings.numeric_summary_bin_count);
+            }
+
+            auto statistics_row = typename table_node<string_t>::row{};
+            statistics_row.cells.emplace_back(lit(string_t, "Values: "));
+            if (statistics.finite_count != 0)
+            {
+                statistics_row.cells.emplace_back(string_t{lit(string_t, "Min: ")} +
+                                                  to_string<string_t>(statistics.min));
+                statistics_row.cells.emplace_back(string_t{lit(string_t, "Max: ")} +
+                                                  to_string<string_t>(statistics.max));
+                statistics_row.cells.emplace_back(string_t{lit(string_t, "Mean: ")} +
+                                                  to_string<string_t>(statistics.mean));
+                statistics_row.cells.emplace_back(string_t{lit(string_t, "Std dev: ")} +
+                                                  to_string<string_t>(statistics.standard_deviation));
+            }
+            statistics_row.cells.emplace_back(string_t{lit(string_t, "NaN: ")} +
+                                              to_string<string_t>(statistics.nan_count));
+            statistics_row.cells.emplace_back(string_t{lit(string_t, "Inf: ")} +
+                                              to_string<string_t>(statistics.infinity_count));
+            container_node.add_row(std::move(statistics_row));
+
+            if (statistics.finite_count == 0)
+            {
+                return;
+            }
+            auto histogram_bins_row = typename table_node<string_t>::row{};
+            auto histogram_counts_row = typename table_node<string_t>::row{};
+            histogram_bins_row.cells.emplace_back(lit(string_t, "From: "));
+            histogram_counts_row.cells.emplace_back(lit(string_t, "Count: "));
+            for (size_t bin = 0; bin < statistics.histogram.size(); ++bin)
+            {
+                histogram_bins_row.cells.emplace_back(to_string<string_t>(statistics.get_bin_start(bin)));
+                histogram_counts_row.cells.emplace_back(to_string<string_t>(statistics.histogram[bin]));
+            }
+            container_node.add_row(std::move(histogram_bins_row));
+            container_node.add_row(std::move(histogram_counts_row));
+        }
+    }
+
+    template <typename linear_container_t>
+    void add_matrix_rows(const linear_container_t &container, const size_t row_count,
+                         table_node<string_t> &container_node) const
+    {
+        // | Matrix: <Rows> x <Columns> | Blocks: <Rows> x <Columns> | Pooling: <Pooling> | Jagged rows: <Count> |
+        // | <Block 1, 1> | <Block 1, 2> | ... |
+        // | <Block 2, 1> | <Block 2, 2> | ... |
+        // Blocks may differ by one row or column: their lengths are then shown as <Min>-<Max>.
+        using row_t = typename linear_container_t::value_type;
+        if constexpr (impl::is_matrix_row_v<row_t>)
+        {
+            struct block
+            {
+                double min{std::numeric_limits<double>::infinity()};
+                double max{-std::numeric_limits<double>::infinity()};
+                double sum{0.0};
+                size_t count{0};
+            };
+
+            // 1. Shape of the matrix. Its columns are the ones of the longest row.
+            size_t column_count = 0;
+            size_t min_row_length = row_count == 0 ? 0 : std::numeric_limits<size_t>::max();
+            size_t rows_heap_bytes = 0;
+            for (const row_t &row : container)
+            {
+                column_count = std::max(column_count, std::size(row));
+                min_row_length = std::min(min_row_length, std::size(row));
+                rows_heap_bytes += impl::get_owned_heap_bytes(row);
+            }
+            container_node.add_owned_heap_bytes(rows_heap_bytes);
+            size_t jagged_row_count = 0;
+            if (min_row_length != column_count)
+            {
+                for (const row_t &row : container)
+                {
+                    jagged_row_count += std::size(row) != column_count;
+                }
+            }
+
+            // The header shows the lengths of the blocks of this partition.
+            const size_t grid_row_count = std::min(row_count, m_settings.matrix_grid_size);
+            const size_t grid_column_count = std::min(column_count, m_settings.matrix_grid_size);
+            const std::vector<size_t> block_row_starts = impl::get_block_starts(row_count, grid_row_count);
+            const std::vector<size_t> block_column_starts = impl::get_block_starts(column_count, grid_column_count);
+            const matrix_pooling pooling = m_settings.matrix_cell_pooling;
+            const auto pooling_name = pooling == matrix_pooling::min   ? lit(string_t, "min")
+                                      : pooling == matrix_pooling::max ? lit(string_t, "max")
+                                                                       : lit(string_t, "mean");
+
+            auto matrix_row = typename table_node<string_t>::row{};
+            matrix_row.cells.emplace_back(string_t{lit(string_t, "Matrix: ")} + to_string<string_t>(row_count) +
+                                          lit(string_t, " x ") + to_string<string_t>(column_count));
+            matrix_row.cells.emplace_back(string_t{lit(string_t, "Blocks: ")} +
+                                          impl::get_block_lengths_string<string_t>(block_row_starts) +
+                                          lit(string_t, " x ") +
+                                          impl::get_block_lengths_string<string_t>(block_column_starts));
+            matrix_row.cells.emplace_back(string_t{lit(string_t, "Pooling: ")} + pooling_name);
+            if (jagged_row_count != 0)
+            {
+                matrix_row.cells.emplace_back(string_t{lit(string_t, "Jagged rows: ")} +
+                                              to_string<string_t>(jagged_row_count) + lit(string_t, " (") +
+                                              to_string<string_t>(min_row_length) + lit(string_t, " to ") +
+                                              to_string<string_t>(column_count) + lit(string_t, " columns)"));
+                matrix_row.cells.back().with_background_color(string_t{lit(string_t, "#ff9f9f")});
+            }
+            container_node.add_row(std::move(matrix_row));
+            if (grid_row_count == 0 || grid_column_count == 0)
+            {
+                return;
+            }
+
+            // 2. Pooling. Each row is read contiguously, one block after the other.
+            std::vector<block> blocks(grid_row_count * grid_column_count);
+            size_t row_index = 0;
+            size_t current_grid_row = 0; // Blocks have one row at least.
+            for (const row_t &row : container)
+            {
+                if (row_index == block_row_starts[current_grid_row + 1])
+                {
+                    ++current_grid_row;
+                }
+                block *grid_row_blocks = &blocks[current_grid_row * grid_column_count];
+                const auto *values = std::data(row);
+                const size_t row_length = std::size(row);
+                for (size_t grid_column = 0; grid_column < grid_column_count; ++grid_column)
+                {
+                    const size_t end = std::min(block_column_starts[grid_column + 1], row_length);
+                    block &current_block = grid_row_blocks[grid_column];
+                    for (size_t column = block_column_starts[grid_column]; column < end; ++column)
+                    {
+                        const auto value = static_cast<double>(values[column]);
+                        if (std::isfinite(value))
+                        {
+                            current_block.min = std::min(current_block.min, value);
+                            current_block.max = std::max(current_block.max, value);
+                            current_block.sum += value;
+                            ++current_block.count;
+                        }
+                    }
+                }
+                ++row_index;
+            }
+
+            // 3. One cell per block, colored between the lowest and highest pooled values.
+            std::vector<double> pooled_values(blocks.size());
+            double lowest_value = std::numeric_limits<double>::infinity();
+            double highest_value = -std::numeric_limits<double>::infinity();
+            for (size_t block_index = 0; block_index < blocks.size(); ++block_index)
+            {
+                const block &current_block = blocks[block_index];
+                pooled_values[block_index] = pooling == matrix_pooling::min   ? current_block.min
+                                             : pooling == matrix_pooling::max ? current_block.max
+                                                                              : current_block.sum / current_block.count;
+                if (current_block.count != 0)
+                {
+                    lowest_value = std::min(lowest_value, pooled_values[block_index]);
+                    highest_value = std::max(highest_value, pooled_values[block_index]);
+                }
+            }
+            for (size_t grid_row = 0; grid_row < grid_row_count; ++grid_row)
+            {
+                auto cells_row = typename table_node<string_t>::row{};
+                for (size_t grid_column = 0; grid_column < grid_column_count; ++grid_column)
+                {
+                    const size_t block_index = grid_row * grid_column_count + grid_column;
+                    if (blocks[block_index].count == 0)
+                    {
+                        // Beyond the end of jagged rows, or only NaNs and infinities.
+                        cells_row.cells.emplace_back(string_t{});
+                        continue;
+                    }
+                    const double value = pooled_values[block_index];
+                    auto value_str = std::is_integral_v<typename row_t::value_type> && pooling != matrix_pooling::mean
+                                         ? to_string<string_t>(static_cast<long long>(value))
+                                         : to_string<string_t>(value);
+                    const double heat =
+                        highest_value > lowest_value ? (value - lowest_value) / (highest_value - lowest_value) : 0.0;
+                    cells_row.cells.emplace_back(std::move(value_str))
+                        .with_background_color(impl::get_heat_color<string_t>(heat));
+                }
+                container_node.add_row(std::move(cells_row));
+            }
+        }
+    }
+
+    // Records the hops from each element of a linked list to the next one.
+    template <typename linear_container_t>
+    void record_element_hops(const linear_container_t &container)
+    {
+        locality_metrics container_metrics;
+        const void *previous_value = nullptr;
+        for (const auto &value : container)
+        {
+            if (previous_value != nullptr)
+            {
+                container_metrics.add_hop(reinterpret_cast<uint64_t>(previous_value),
+                                          reinterpret_cast<uint64_t>(&value));
+            }
+            previous_value = &value;
+        }
+        get_locality_metrics(impl::get_type_name<linear_container_t>()).merge(container_metrics);
+    }
+
+    // Records the hop from where a non-null pointer is stored to the object it points to.
+    template <typename pointer_t>
+    void record_pointer_hop(const void *pointer_address, const pointer_t pointer)
+    {
+        using pointed_t = std::remove_cv_t<std::remove_pointer_t<pointer_t>>;
+        get_locality_metrics(impl::get_type_name<pointed_t>())
+            .add_hop(reinterpret_cast<uint64_t>(pointer_address), reinterpret_cast<uint64_t>(pointer));
+    }
+
+    locality_metrics &get_locality_metrics(const std::string_view type_name)
+    {
+        // Type names point to static storage: their address identifies the type.
+        locality_metrics &metrics = m_locality_by_type[type_name.data()];
+        metrics.type_name = type_name;
+        return metrics;
+    }
+
+    // Adds the memory details of a container to its header row (see set_capacity_reporting).
+    template <typename linear_container_t>
+    void add_capacity_cells(const linear_container_t &container, const size_t length,
+                            typename table_node<string_t>::row &header_row) const
+    {
+        using value_t = typename linear_container_t::value_type;
+
+        // | <Type name> | <Address> | Length: <Length> | Capacity: <Capacity> | Slack: <Bytes> B |
+        if constexpr (impl::is_specialization<linear_container_t, std::vector>::value)
+        {
+            const size_t slack_bytes = impl::get_slack_bytes(container);
+            auto capacity_str = string_t{lit(string_t, "Capacity: ")} + to_string<string_t>(container.capacity());
+            auto slack_str =
+                string_t{lit(string_t, "Slack: ")} + to_string<string_t>(slack_bytes) + lit(string_t, " B");
+            header_row.cells.emplace_back(cell_t{std::move(capacity_str)}.spanning_columns(2));
+            header_row.cells.emplace_back(cell_t{std::move(slack_str)}.spanning_columns(2));
+            if (slack_bytes >= m_settings.highlighted_slack_bytes)
+            {
+                const string_t highlight_color{lit(string_t, "#ff9f9f")};
+                header_row.cells.front().with_background_color(highlight_color);
+                header_row.cells.back().with_background_color(highlight_color);
+            }
+        }
+
+        // | ... | Length: <Length> | Overhead: <Bytes> B (<Bytes per element> B/element) |
+        if constexpr (impl::get_element_link_bytes<linear_container_t>() != 0)
+        {
+            constexpr size_t link_bytes = impl::get_element_link_bytes<linear_container_t>();
+            auto overhead_str = string_t{lit(string_t, "Overhead: ")} + to_string<string_t>(length * link_bytes) +
+                                lit(string_t, " B (") + to_string<string_t>(link_bytes) + lit(string_t, " B/element)");
+            header_row.cells.emplace_back(cell_t{std::move(overhead_str)}.spanning_columns(2));
+        }
+
+        // | ... | Length: <Length> | Inline strings: <Count> / <Length> |
+        if constexpr (impl::is_specialization<value_t, std::basic_string>::value)
+        {
+            const auto inline_count = static_cast<size_t>(
+                std::count_if(std::cbegin(container), std::cend(container),
+                              [](const value_t &value) { return impl::is_stored_inline(value); }));
+            auto inline_str = string_t{lit(string_t, "Inline strings: ")} + to_string<string_t>(inline_count) +
+                              lit(string_t, " / ") + to_string<string_t>(length);
+            header_row.cells.emplace_back(cell_t{std::move(inline_str)}.spanning_columns(2));
+        }
+    }
+
+    // Adds the memory resource of a container to its header row, if its allocator declares one (see
+    // traits::memory_resource): its name given to name_memory_resource, or its address.
+    template <typename container_t>
+    void add_memory_resource_cell(const container_t &container, typename table_node<string_t>::row &header_row) const
+    {
+        if constexpr (impl::has_allocator<container_t>::value)
+        {
+            using allocator_t = typename container_t::allocator_type;
+            if constexpr (traits::has_memory_resource_v<allocator_t>)
+            {
+                const void *resource =
+                    traits::memory_resource<allocator_t>::get_memory_resource(container.get_allocator());
+                const auto name = m_settings.memory_resource_names.find(resource);
+                auto resource_str = string_t{lit(string_t, "Resource: ")} +
+                                    (name != m_settings.memory_resource_names.cend()
+                                         ? name->second
+                                         : impl::get_address_as_string<string_t>(resource));
+                header_row.cells.emplace_back(cell_t{std::move(resource_str)}.spanning_columns(2));
+            }
+        }
+    }
+
+    // Adds a data structure reached from the node being built. During a capture step, only its node ID is computed, and
+    // its traversal is deferred to a later node.
+    // A first member has the node ID of its instance, whose node exists before a deferred traversal would run: such
+    // members are traversed right away, as add_data_structure does.
+    template <typename data_t>
+    uint64_t add_child_data_structure(const data_t &data_structure)
+    {
+        if (!m_is_capture_step_running)
+        {
+            return traverse_data_structure(data_structure);
+        }
+
+        const uint64_t node_id = impl::get_node_id_for_value(data_structure);
+        if (is_adapted_class_traversed(node_id))
+        {
+            return traverse_data_structure(data_structure);
+        }
+        if (!has_node(node_id))
+        {
+            m_deferred_captures.emplace_back([this, &data_structure] { traverse_data_structure(data_structure); });
+        }
+        return node_id;
+    }
+
+    // True while the members of an adapted class instance with this node ID are traversed.
+    [[nodiscard]] bool is_adapted_class_traversed(const uint64_t node_id) const
+    {
+        const auto traversal = m_adapted_class_traversals.lower_bound({node_id, nullptr});
+        return traversal != m_adapted_class_traversals.end() && traversal->first == node_id;
+    }
+
+    template <typename linear_container_t>
+    [[nodiscard]] bool should_traverse_in_parallel(const std::ptrdiff_t length) const
+    {
+        if constexpr (impl::is_random_access_container_v<linear_container_t>)
+        {
+            // The parallel traversal does not fit in the budget of a capture step.
+            return !m_is_capture_step_running && m_parallel_thread_count > 1 &&
+                   static_cast<size_t>(length) >= 2 * m_parallel_elements_per_task;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    // Adds the cell of a linear container element displayed as a separate node, and the edge going from this cell to
+    // the element's node.
+    template <member_display_type element_display_type, typename value_t>
+    void add_element_cell_and_edge(const value_t &value, const size_t index, const uint64_t container_node_id,
+                                   const uint64_t element_node_id, typename table_node<string_t>::row &values_row)
+    {
+        const auto port_name = cdv::to_string<string_t>(index);
+
+        // value_t is a pointer type: the ADDRESS in the cell, and a pointer edge (if not null).
+        if constexpr (element_display_type == member_display_type::pointer_edge)
+        {
+            values_row.cells.emplace_back(cell_t{impl::get_address_as_string<string_t>(value)}.with_port(port_name));
+            if (value != nullptr)
+            {
+                record_pointer_hop(&value, value);
+                add_edge(arrow<string_t>{container_node_id, port_name, element_node_id, lit(string_t, "")});
+            }
+        }
+        // Otherwise: the INDEX in the cell, and a composition edge.
+        else
+        {
+            mark_embedded_node(element_node_id);
+            values_row.cells.emplace_back(cell_t{cdv::to_string<string_t>(index)}.with_port(port_name));
+            add_edge(arrow<string_t>{container_node_id, port_name, element_node_id, lit(string_t, "")}.with_style(
+                edge_style::dashed));
+        }
+    }
+
+    // Builds the subgraphs of the elements of a random-access container on the work-stealing pool.
+    // Each task traverses a range of elements into its own visualization. The task results are then merged in element
+    // order, which keeps the output independent of the scheduling.
+    template <member_display_type element_display_type, typename linear_container_t>
+    void add_elements_in_parallel(const linear_container_t &container, const uint64_t container_node_id,
+                                  typename table_node<string_t>::row &values_row)
+    {
+        // Never called on other containers, but still instantiated.
+        if constexpr (impl::is_random_access_container_v<linear_container_t>)
+        {
+            const size_t length = std::size(container);
+            const size_t task_count = (length + m_parallel_elements_per_task - 1) / m_parallel_elements_per_task;
+            std::vector<visualization> task_results(task_count); // Sequential traversal inside the tasks.
+            for (visualization &task_result : task_results)
+            {
+                task_result.m_settings = m_settings;
+            }
+            std::vector<uint64_t> element_node_ids(length, impl::nullptr_pointer_node_id);
+
+            impl::run_work_stealing(task_count, m_parallel_thread_count, [&](const size_t task_index) {
+                const size_t first = task_index * m_parallel_elements_per_task;
+                const size_t last = std::min(first + m_parallel_elements_per_task, length);
+                auto iterator = std::cbegin(container) + first;
+                for (size_t index = first; index < last; ++index, ++iterator)
+                {
+                    if constexpr (element_display_type == member_display_type::pointer_edge)
+                    {
+                        if (*iterator != nullptr)
+                        {
+                            element_node_ids[index] = task_results[task_index].traverse_data_structure(**iterator);
+                        }
+                    }
+                    else
+                    {
+                        element_node_ids[index] = task_results[task_index].traverse_data_structure(*iterator);
+                    }
+                }
+            });
+
+            auto iterator = std::cbegin(container);
+            for (size_t task_index = 0; task_index < task_count; ++task_index)
+            {
+                merge_traversal(std::move(task_results[task_index]));
+
+                const size_t first = task_index * m_parallel_elements_per_task;
+                const size_t last = std::min(first + m_parallel_elements_per_task, length);
+                for (size_t index = first; index < last; ++index, ++iterator)
+                {
+                    add_element_cell_and_edge<element_display_type>(*iterator, index, container_node_id,
+                                                                    element_node_ids[index], values_row);
+                }
+            }
+        }
+    }
+
+    struct memory_region
+    {
+        cluster<string_t> appearance;
+        std::vector<uint64_t> node_ids;
+    };
+
+    // Nodes standing for several nodes of the graph in the DOT export, see dot_export_options.
+    struct graph_summary
+    {
+        // Key   = ID of a summarized node.
+        // Value = ID of the node summarizing it, the one of the first node it summarizes.
+        std::unordered_map<uint64_t, uint64_t> summary_node_ids;
+        // Key   = ID of a summary node.
+        // Value = the summary node.
+        std::unordered_map<uint64_t, table_node<string_t>> summary_nodes;
+        // Key   = ID of a node identical to an earlier node, and not summarized.
+        // Value = ID of the first node identical to it, which has the same ports.
+        std::unordered_map<uint64_t, uint64_t> identical_node_ids;
+        // Key   = ID of the first node of identical nodes.
+        // Value = number of identical nodes.
+        std::unordered_map<uint64_t, size_t> identical_node_counts;
+
+        [[nodiscard]] uint64_t get_node_id(const uint64_t node_id) const
+        {
+            const auto summary_node_id = summary_node_ids.find(node_id);
+            return summary_node_id != summary_node_ids.end() ? summary_node_id->second : node_id;
+        }
+
+        [[nodiscard]] bool is_empty() const
+        {
+            return summary_node_ids.empty() && identical_node_ids.empty();
+        }
+    };
+
+    // Collapses the big strongly connected components, folds the long chains and merges the identical subgraphs of
+    // the graph, see dot_export_options. Runs in O(n + m) for n nodes and m edges, plus the length of the nodes' DOT
+    // strings when merging identical subgraphs.
+    [[nodiscard]] graph_summary summarize_graph(const dot_export_options &options) const
+    {
+        const size_t collapsed_component_min_size = options.collapsed_component_min_size;
+        const size_t folded_chain_min_length = options.folded_chain_min_length;
+        constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+        using cell_t = typename table_node<string_t>::cell;
+
+        // Dense graph: vertex i is the node m_node_order[i]. Self-loops change neither the components nor the chains.
+        const auto vertex_count = static_cast<uint32_t>(m_node_order.size());
+        std::unordered_map<uint64_t, uint32_t> vertices_by_node_id;
+        vertices_by_node_id.reserve(vertex_count);
+        for (uint32_t vertex = 0; vertex < vertex_count; ++vertex)
+        {
+            vertices_by_node_id.emplace(m_node_order[vertex], vertex);
+        }
+        std::vector<uint32_t> edge_offsets(vertex_count + 1, 0);
+        std::vector<uint32_t> in_degrees(vertex_count, 0);
+        std::vector<uint32_t> predecessors(vertex_count, none); // Last one, only used for a single one.
+        std::vector<bool> has_self_loop(vertex_count, false);
+        std::vector<std::pair<uint32_t, uint32_t>> edges; // Source vertex, index in m_directed_edges.
+        edges.reserve(m_directed_edges.size());
+        std::vector<uint32_t> edge_destinations(m_directed_edges.size(), none);
+        for (size_t edge_index = 0; edge_index < m_directed_edges.size(); ++edge_index)
+        {
+            const arrow<string_t> &edge = m_directed_edges[edge_index];
+            const auto source = vertices_by_node_id.find(edge.source_node_id);
+            const auto destination = vertices_by_node_id.find(edge.destination_node_id);
+            if (source == vertices_by_node_id.end() || destination == vertices_by_node_id.end())
+            {
+                continue;
+            }
+            if (source->second == destination->second)
+            {
+                has_self_loop[source->second] = true;
+                continue;
+            }
+            edges.emplace_back(source->second, static_cast<uint32_t>(edge_index));
+            edge_destinations[edge_index] = destination->second;
+            ++edge_offsets[source->second + 1];
+            ++in_degrees[destination->second];
+            predecessors[destination->second] = source->second;
+        }
+        std::partial_sum(edge_offsets.begin(), edge_offsets.end(), edge_offsets.begin());
+        std::vector<uint32_t> edge_targets(edges.size());
+        std::vector<uint32_t> edge_indices(edges.size());
+        std::vector<uint32_t> edge_ends(edge_offsets.begin(), edge_offsets.end() - 1);
+        for (const auto &[source, edge_index] : edges)
+        {
+            edge_indices[edge_ends[source]] = edge_index;
+            edge_targets[edge_ends[source]++] = edge_destinations[edge_index];
+        }
+        edges = {};
+        edge_destinations = {};
+
+        impl::strongly_connected_components components;
+        if (collapsed_component_min_size > 0 || options.merge_identical_subgraphs)
+        {
+            components = impl::find_strongly_connected_components(edge_offsets, edge_targets);
+        }
+
+        graph_summary summary;
+        const auto get_type_name = [this](const uint32_t vertex) {
+            return m_nodes.find(m_node_order[vertex])->second->get_memory_footprint().type_name;
+        };
+        const auto make_type_count_cell = [](const size_t count, const std::string_view type_name) {
+            string_t text = cdv::to_string<string_t>(count);
+            if (type_name.empty()) // Nodes added by hand.
+            {
+                text += lit(string_t, " nodes");
+            }
+            else
+            {
+                text += lit(string_t, " &times; ");
+                text += impl::get_type_name_html<string_t>(type_name);
+            }
+            return cell_t{std::move(text)};
+        };
+
+        // 1. Strongly connected components, summarized by their number of nodes per type.
+        std::vector<bool> is_collapsed(vertex_count, false);
+        if (collapsed_component_min_size > 0)
+        {
+            std::vector<uint32_t> component_sizes(components.component_count, 0);
+            for (const uint32_t component : components.vertex_components)
+            {
+                ++component_sizes[component];
+            }
+
+            // Number of nodes per type of each collapsed component, in order of first appearance.
+            std::vector<uint32_t> first_vertices(components.component_count, none);
+            std::unordered_map<uint32_t, std::vector<std::pair<std::string_view, size_t>>> type_counts;
+            for (uint32_t vertex = 0; vertex < vertex_count; ++vertex)
+            {
+                const uint32_t component = components.vertex_components[vertex];
+                if (component_sizes[component] < std::max<size_t>(collapsed_component_min_size, 2))
+                {
+                    continue;
+                }
+                if (first_vertices[component] == none)
+                {
+                    first_vertices[component] = vertex;
+                }
+                is_collapsed[vertex] = true;
+                summary.summary_node_ids.emplace(m_node_order[vertex], m_node_order[first_vertices[component]]);
+
+                auto &component_type_counts = type_counts[component];
+                const std::string_view type_name = get_type_name(vertex);
+                const auto type_count =
+                    std::find_if(component_type_counts.begin(), component_type_counts.end(),
+                                 [type_name](const auto &count) { return count.first == type_name; });
+                if (type_count != component_type_counts.end())
+                {
+                    ++type_count->second;
+                }
+                else
+                {
+                    component_type_counts.emplace_back(type_name, 1);
+                }
+            }
+
+            // |---------------------------------|
+            // | Strongly connected: <N> nodes   |
+            // |---------------------------------|
+            // | <Count 1> x <Type name 1>       |
+            // |---------------------------------|
+            // |              ...                |
+            // |---------------------------------|
+            constexpr size_t max_displayed_type_count = 8;
+            for (const auto &[component, component_type_counts] : type_counts)
+            {
+                string_t heading = lit(string_t, "<b>Strongly connected</b>: ");
+                heading += cdv::to_string<string_t>(component_sizes[component]);
+                heading += lit(string_t, " nodes");
+                auto summary_node = table_node<string_t>{}.with_row(cell_t{std::move(heading)});
+                for (size_t index = 0; index < component_type_counts.size(); ++index)
+                {
+                    if (index == max_displayed_type_count)
+                    {
+                        summary_node.add_row(cell_t{string_t{lit(string_t, "...")}});
+                        break;
+                    }
+                    summary_node.add_row(
+                        make_type_count_cell(component_type_counts[index].second, component_type_counts[index].first));
+                }
+                summary.summary_nodes.emplace(m_node_order[first_vertices[component]], std::move(summary_node));
+            }
+        }
+
+        // 2. Chains, whose inner nodes are summarized by their number and type.
+        if (folded_chain_min_length > 0)
+        {
+            const auto is_linear = [&](const uint32_t vertex) {
+                return vertex != none && !is_collapsed[vertex] && in_degrees[vertex] == 1 &&
+                       edge_offsets[vertex + 1] - edge_offsets[vertex] == 1;
+            };
+
+            // |------------------------------------------|
+            // | <Count 1> x <Type name 1>                |
+            // |------------------------------------------|
+            // | <Count 2> x <Type name 2> (if any)       |
+            // |------------------------------------------|
+            // | <First address> ... <Last address>       |
+            // |------------------------------------------|
+            const auto fold_chain = [&](const std::vector<uint32_t> &chain) {
+                if (chain.size() < std::max<size_t>(folded_chain_min_length, 3))
+                {
+                    return;
+                }
+                const uint64_t first_node_id = m_node_order[chain[1]];
+                const uint64_t last_node_id = m_node_order[chain[chain.size() - 2]];
+                const size_t inner_count = chain.size() - 2;
+                table_node<string_t> summary_node;
+                if (inner_count == 1 || get_type_name(chain[1]) == get_type_name(chain[2]))
+                {
+                    summary_node.add_row(make_type_count_cell(inner_count, get_type_name(chain[1])));
+                }
+                else
+                {
+                    summary_node.add_row(make_type_count_cell((inner_count + 1) / 2, get_type_name(chain[1])));
+                    summary_node.add_row(make_type_count_cell(inner_count / 2, get_type_name(chain[2])));
+                }
+                string_t addresses = impl::get_address_as_string<string_t>(reinterpret_cast<void *>(first_node_id));
+                addresses += lit(string_t, " ... ");
+                addresses += impl::get_address_as_string<string_t>(reinterpret_cast<void *>(last_node_id));
+                summary_node.add_row(cell_t{std::move(addresses)});
+
+                for (size_t position = 1; position + 1 < chain.size(); ++position)
+                {
+                    summary.summary_node_ids.emplace(m_node_order[chain[position]], first_node_id);
+                }
+                summary.summary_nodes.emplace(first_node_id, std::move(summary_node));
+            };
+
+            // Chains start after a node that is not linear. Cycles made of linear nodes only are left as they are.
+            std::vector<bool> is_chained(vertex_count, false);
+            std::vector<uint32_t> chain;
+            for (uint32_t start = 0; start < vertex_count; ++start)
+            {
+                if (!is_linear(start) || is_chained[start] || is_linear(predecessors[start]))
+                {
+                    continue;
+                }
+                for (uint32_t vertex = start; is_linear(vertex) && !is_chained[vertex];
+                     vertex = edge_targets[edge_offsets[vertex]])
+                {
+                    if (chain.size() >= 2 && get_type_name(vertex) != get_type_name(chain[chain.size() - 2]))
+                    {
+                        fold_chain(chain);
+                        chain.clear();
+                    }
+                    is_chained[vertex] = true;
+                    chain.push_back(vertex);
+                }
+                fold_chain(chain);
+                chain.clear();
+            }
+        }
+
+        // 3. Identical subgraphs. Components are numbered in reverse topological order: the classes of the nodes an
+        // edge leads to are known before the class of its source node.
+        if (options.merge_identical_subgraphs)
+        {
+            std::vector<uint32_t> component_offsets(components.component_count + 1, 0);
+            for (const uint32_t component : components.vertex_components)
+            {
+                ++component_offsets[component + 1];
+            }
+            std::partial_sum(component_offsets.begin(), component_offsets.end(), component_offsets.begin());
+            std::vector<uint32_t> component_vertices(vertex_count);
+            std::vector<uint32_t> component_ends(component_offsets.begin(), component_offsets.end() - 1);
+            for (uint32_t vertex = 0; vertex < vertex_count; ++vertex)
+            {
+                component_vertices[component_ends[components.vertex_components[vertex]]++] = vertex;
+            }
+
+            // Class of identical nodes of each vertex, and key of each class: the DOT string of its nodes with their
+            // addresses and the addresses of the nodes they lead to masked, followed by their edges.
+            std::vector<uint32_t> vertex_classes(vertex_count, none);
+            std::vector<string_t> class_keys;
+            std::unordered_map<size_t, std::vector<uint32_t>> classes_by_key_hash;
+            for (uint32_t component = 0; component < components.component_count; ++component)
+            {
+                const uint32_t vertex = component_vertices[component_offsets[component]];
+                const uint64_t node_id = m_node_order[vertex];
+                if (component_offsets[component + 1] - component_offsets[component] > 1 || has_self_loop[vertex] ||
+                    summary.summary_node_ids.count(node_id) != 0)
+                {
+                    // Unique classes, without key.
+                    for (uint32_t position = component_offsets[component]; position < component_offsets[component + 1];
+                         ++position)
+                    {
+                        vertex_classes[component_vertices[position]] = static_cast<uint32_t>(class_keys.size());
+                        class_keys.emplace_back();
+                    }
+                    continue;
+                }
+
+                // Not reused: clearing a set costs as much as its biggest size.
+                std::unordered_set<uint64_t> masked_addresses{node_id};
+                string_t edges_key;
+                for (uint32_t edge = edge_offsets[vertex]; edge < edge_offsets[vertex + 1]; ++edge)
+                {
+                    const arrow<string_t> &arrow = m_directed_edges[edge_indices[edge]];
+                    masked_addresses.insert(arrow.destination_node_id);
+                    edges_key += lit(string_t, "\n");
+                    edges_key += arrow.source_port;
+                    edges_key += lit(string_t, "->");
+                    edges_key += cdv::to_string<string_t>(vertex_classes[edge_targets[edge]]);
+                    edges_key += lit(string_t, ":");
+                    edges_key += arrow.destination_port;
+                    edges_key += lit(string_t, " ");
+                    edges_key += cdv::to_string<string_t>(static_cast<int>(arrow.style));
+                    edges_key += lit(string_t, " ");
+                    edges_key += cdv::to_string<string_t>(static_cast<int>(arrow.shape));
+                }
+                const base_node<string_t> &node = *m_nodes.find(node_id)->second;
+                string_t key = impl::mask_addresses(
+                    node.generate_structure_string(cluster<string_t>::default_node_appearance), masked_addresses);
+                key += edges_key;
+
+                std::vector<uint32_t> &candidate_classes = classes_by_key_hash[std::hash<string_t>{}(key)];
+                const auto identical_class =
+                    std::find_if(candidate_classes.begin(), candidate_classes.end(),
+                                 [&](const uint32_t candidate_class) { return class_keys[candidate_class] == key; });
+                if (identical_class != candidate_classes.end())
+                {
+                    vertex_classes[vertex] = *identical_class;
+                }
+                else
+                {
+                    vertex_classes[vertex] = static_cast<uint32_t>(class_keys.size());
+                    candidate_classes.push_back(vertex_classes[vertex]);
+                    class_keys.emplace_back(std::move(key));
+                }
+            }
+            class_keys = {};
+
+            // The first node of each class stands for the others.
+            std::vector<uint32_t> first_vertices(vertex_classes.size(), none);
+            for (uint32_t vertex = 0; vertex < vertex_count; ++vertex)
+            {
+                uint32_t &first_vertex = first_vertices[vertex_classes[vertex]];
+                if (first_vertex == none)
+                {
+                    first_vertex = vertex;
+                }
+                else
+                {
+                    summary.identical_node_ids.emplace(m_node_order[vertex], m_node_order[first_vertex]);
+                    ++summary.identical_node_counts.try_emplace(m_node_order[first_vertex], 1).first->second;
+                }
+            }
+        }
+        return summary;
+    }
+
+    // Groups the nodes by the memory region of their object, in node order. Nodes out of any region are left in
+    // ungrouped_node_ids.
+    [[nodiscard]] std::vector<memory_region> group_nodes_by_memory_region(
+        const memory_region_grouping grouping, std::vector<uint64_t> &ungrouped_node_ids) const
+    {
+        constexpr uint64_t page_bytes = locality_metrics::page_bytes;
+        constexpr uint64_t huge_page_bytes = uint64_t{1} << 21;
+
+        std::vector<memory_region> regions;
+        std::unordered_map<uint64_t, size_t> region_indices; // Page or arena index -> index in regions.
+        for (const uint64_t node_id : m_node_order)
+        {
+            std::optional<uint64_t> region_key;
+            if (m_nodes.find(node_id)->second->get_memory_footprint().object_bytes != 0)
+            {
+                if (grouping == memory_region_grouping::page)
+                {
+                    region_key = node_id / page_bytes;
+                }
+                else if (grouping == memory_region_grouping::huge_page)
+                {
+                    region_key = node_id / huge_page_bytes;
+                }
+                else
+                {
+                    const auto arena = std::find_if(m_settings.memory_arenas.begin(), m_settings.memory_arenas.end(),
+                                                    [node_id](const memory_arena<string_t> &arena) {
+                                                        return node_id >= arena.begin_address &&
+                                                               node_id < arena.end_address;
+                                                    });
+                    if (arena != m_settings.memory_arenas.end())
+                    {
+                        region_key = static_cast<uint64_t>(arena - m_settings.memory_arenas.begin());
+                    }
+                }
+            }
+            if (!region_key.has_value())
+            {
+                ungrouped_node_ids.emplace_back(node_id);
+                continue;
+            }
+
+            const auto [region_index, is_new_region] = region_indices.try_emplace(*region_key, regions.size());
+            if (is_new_region)
+            {
+                memory_region region;
+                if (grouping == memory_region_grouping::arena)
+                {
+                    region.appearance = m_settings.memory_arenas[*region_key].appearance;
+                }
+                else
+                {
+                    const bool is_page = grouping == memory_region_grouping::page;
+                    const auto *region_begin =
+                        reinterpret_cast<const void *>(*region_key * (is_page ? page_bytes : huge_page_bytes));
+                    region.appearance.cluster_label = string_t{lit(string_t, "\"")} +
+                                                      (is_page ? lit(string_t, "page ") : lit(string_t, "huge page ")) +
+                                                      impl::get_address_as_string<string_t>(region_begin) +
+                                                      lit(string_t, "\"");
+                }
+                regions.emplace_back(std::move(region));
+            }
+            regions[region_index->second].node_ids.emplace_back(node_id);
+        }
+        return regions;
+    }
+
+    // Moves the nodes of another traversal that are not in this visualization yet into it, along with their outgoing
+    // edges. A node's outgoing edges are always created along with the node itself, so the edges of the nodes that
+    // already exist here are duplicates and are dropped.
+    void merge_traversal(visualization &&other)
+    {
+        std::unordered_set<uint64_t> merged_node_ids;
+        for (const uint64_t node_id : other.m_node_order)
+        {
+            if (!has_node(node_id))
+            {
+                store_node(node_id, std::move(other.m_nodes.find(node_id)->second));
+                merged_node_ids.insert(node_id);
+            }
+        }
+
+        for (arrow<string_t> &edge : other.m_directed_edges)
+        {
+            if (merged_node_ids.find(edge.source_node_id) != merged_node_ids.end())
+            {
+                add_edge(std::move(edge));
+            }
+        }
+        m_embedded_node_ids.insert(other.m_embedded_node_ids.begin(), other.m_embedded_node_ids.end());
+        for (const auto &[type_key, metrics] : other.m_locality_by_type)
+        {
+            get_locality_metrics(metrics.type_name).merge(metrics);
+        }
+    }
+
+    template <typename adapted_class_t, size_t... member_indices, typename... member_descriptors_t>
+    void add_rows_for_members(
+        const adapted_class_t &data_structure, const uint64_t instance_node_id,
+        adapted_class_node<string_t> &node_for_data_structure,
+        const traits::member_table_entries<std::index_sequence<member_indices...>, member_descriptors_t...>
+            &member_table)
+    {
+        (add_row_for_member(
+             data_structure, instance_node_id, node_for_data_structure, member_indices,
+             static_cast<const traits::member_table_entry<member_indices, member_descriptors_t> &>(member_table)
+                 .descriptor),
+         ...);
+    }
+
+    template <typename adapted_class_t, typename member_descriptor_t>
+    void add_row_for_member(const adapted_class_t &data_structure, const uint64_t instance_node_id,
+                            adapted_class_node<string_t> &node_for_data_structure, const size_t member_index,
+                            const member_descriptor_t &member_descriptor)
+    {
+        // member_descriptor.get_member_name()  : unit -> string_t
+        // member_descriptor.get_member_value() : const adapted_class_t& instance -> auto
+        // member_descriptor.display_member()   : const adapted_class_t& instance -> bool
+
+        // Only reads the member: the row itself is added by add_member_row, which only depends on the type of the
+        // member and is therefore shared by all the classes having members of this type.
+        if (member_descriptor.display_member(data_structure))
+        {
+            decltype(auto) member_value = member_descriptor.get_member_value(data_structure);
+            using member_value_t = decltype(member_value);
+            // Values returned by value (std::unique_ptr::get) are not stored anywhere: the closest address is the one
+            // of the instance holding them.
+            const void *member_address;
+            if constexpr (std::is_reference_v<member_value_t>)
+            {
+                member_address = &member_value;
+            }
+            else
+            {
+                member_address = &data_structure;
+            }
+            add_member_row<!std::is_reference_v<member_value_t>, impl::get_pointer_ownership<member_descriptor_t>()>(
+                instance_node_id, node_for_data_structure, member_index, member_value, member_address);
+        }
+    }
+
+    // Adds the row of a member, whose name and port are already in the skeleton of the node. Members returned by value
+    // are temporaries: their children cannot be deferred. Weak pointers are drawn as dotted edges. The member address
+    // is where a pointer member is stored, the start of its hop (see get_locality_by_type).
+    template <bool is_temporary_member, pointer_ownership ownership, typename member_t>
+    void add_member_row(const uint64_t instance_node_id, adapted_class_node<string_t> &node_for_data_structure,
+                        const size_t member_index, const member_t &member_value, const void *member_address)
+    {
+        constexpr member_display_type data_display_type = impl::get_data_display_type<const member_t &>();
+        const string_t &port_name = node_for_data_structure.get_skeleton().port_names[member_index];
+
+        if constexpr (data_display_type == member_display_type::inside)
+        {
+            node_for_data_structure.add_member_value(member_index, cdv::to_string<string_t>(member_value));
+            if constexpr (!is_temporary_member)
+            {
+                node_for_data_structure.add_owned_heap_bytes(impl::get_owned_heap_bytes(member_value));
+            }
+        }
+        else if constexpr (data_display_type == member_display_type::composition_edge)
+        {
+            // Address in the instance table.
+            node_for_data_structure.add_member_value(
+                member_index, impl::get_address_as_string<string_t>(impl::get_identifying_address(member_value)));
+
+            // Node for the value.
+            uint64_t pointed_node_id;
+            if constexpr (is_temporary_member)
+            {
+                pointed_node_id = traverse_data_structure(member_value);
+            }
+            else
+            {
+                // The first member has the node ID of the instance, whose node replaces the member's one. Views do not
+                // own the values they show.
+                pointed_node_id = add_child_data_structure(member_value);
+                if (pointed_node_id != instance_node_id && !traits::is_view_v<member_t>)
+                {
+                    mark_embedded_node(pointed_node_id);
+                }
+            }
+
+            // Edge from the cell to the value.
+            // TODO add_rows_for_members | proper arrow shape for 'composition_edge'
+            add_edge(arrow<string_t>{instance_node_id, port_name, pointed_node_id, lit(string_t, "")}.with_style(
+                traits::is_view_v<member_t> ? edge_style::normal : edge_style::dashed));
+        }
+        else // member_display_method == member_display_type::pointer_edge
+        {
+            // Address in the instance table.
+            node_for_data_structure.add_member_value(member_index,
+                                                     impl::get_address_as_string<string_t>(member_value));
+            if (member_value != nullptr)
+            {
+                record_pointer_hop(member_address, member_value);
+
+                // Node for the pointed value.
+                const uint64_t pointed_node_id = add_child_data_structure(*member_value);
+                // Edge from the cell to the value.
+                // TODO add_rows_for_members | proper arrow shape for 'pointer_edge'
+                auto edge = arrow<string_t>{instance_node_id, port_name, pointed_node_id, lit(string_t, "")};
+                edge.ownership = ownership;
+                if constexpr (ownership == pointer_ownership::weak)
+                {
+                    edge.style = edge_style::dotted;
+                }
+                add_edge(std::move(edge));
+            }
+        }
+    }
+
+    // For custom user types.
+    template <typename adapted_class_t>
+    uint64_t add_adapted_class(const adapted_class_t &data_structure)
+    {
+        // Add a table node referencing all adapted members :
+
+        // |-------------------------------------|
+        // |   <Type name>    |    <Address>     |
+        // |-------------------------------------|
+        // | <Member Name 1>  | <Member Value 1> |
+        // |-------------------------------------|
+        // | <Member Name 2>  | <Member Value 2> |
+        // |-------------------------------------|
+        // |             	...             	 |
+        // |-------------------------------------|
+
+        // Coming back to an instance being traversed closes a cycle, for example of shared pointers: only the edge to
+        // it is added. An instance and its first member have the same node ID, hence the type.
+        const uint64_t node_id = impl::get_node_id_for_value(data_structure);
+        const std::pair<uint64_t, const char *> traversal{node_id, impl::get_type_name<adapted_class_t>().data()};
+        if (has_node(node_id) || m_adapted_class_traversals.count(traversal) != 0)
+        {
+            return node_id;
+        }
+        m_adapted_class_traversals.insert(traversal);
+
+        // Base node with heading row.
+        auto node_for_instance =
+            adapted_class_node<string_t>{impl::get_adapted_class_skeleton<adapted_class_t, string_t>(),
+                                         impl::get_address_as_string<string_t>(&data_structure)};
+        memory_footprint footprint = impl::make_memory_footprint(data_structure);
+        footprint.layout = &impl::get_class_layout(data_structure);
+        node_for_instance.set_memory_footprint(footprint);
+
+        // Loop over adapted members.
+        add_rows_for_members(data_structure, node_id, node_for_instance,
+                             impl::get_member_descriptors<adapted_class_t>());
+        m_adapted_class_traversals.erase(traversal);
+        add_node(node_id, std::move(node_for_instance));
+        return node_id;
+    }
+
+    // For simple types.
+    template <typename simple_type_t>
+    uint64_t add_simple_value(const simple_type_t &data_structure)
+    {
+        // Add a simple table node:
+
+        // |-------------------------|
+        // | <Type name> | <Address> |
+        // |-------------------------|
+        // |     	  <Value>        |
+        // |-------------------------|
+
+        const uint64_t node_id = impl::get_node_id_for_value(data_structure);
+        if (has_node(node_id))
+        {
+            return node_id;
+        }
+
+        auto type_name = impl::get_type_name_string<simple_type_t, string_t>();
+        auto instance_address = impl::get_address_as_string<string_t>(impl::get_identifying_address(data_structure));
+        auto node_for_instance = table_node<string_t>{}
+                                     .with_row(std::move(type_name), std::move(instance_address))
+                                     .with_row(table_node<string_t>::cell::make(data_structure).spanning_columns(2));
+        if constexpr (impl::is_specialization<simple_type_t, std::basic_string>::value)
+        {
+            // |  Inline (SSO)  |  or  |  Heap: <Capacity> chars  |
+            if (m_settings.is_capacity_reporting_enabled)
+            {
+                auto storage_str = impl::is_stored_inline(data_structure)
+                                       ? string_t{lit(string_t, "Inline (SSO)")}
+                                       : string_t{lit(string_t, "Heap: ")} +
+                                             to_string<string_t>(data_structure.capacity()) + lit(string_t, " chars");
+                node_for_instance.add_row(cell_t{std::move(storage_str)}.spanning_columns(2));
+            }
+        }
+        node_for_instance.set_memory_footprint(impl::make_memory_footprint(data_structure));
+        add_node(node_id, std::move(node_for_instance));
+        return node_id;
+    }
+
+    // For raw pointers.
+    template <typename pointer_type_t>
+    uint64_t add_pointer(const pointer_type_t &data_structure)
+    {
+        // Special case for the null pointer.
+        if (data_structure == nullptr)
+        {
+            if (has_node(impl::nullptr_pointer_node_id))
+            {
+                return impl::nullptr_pointer_node_id;
+            }
+
+            auto node_for_pointer = table_node<string_t>{}.with_row(lit(string_t, "nullptr"));
+            add_node(impl::nullptr_pointer_node_id, std::move(node_for_pointer));
+            return impl::nullptr_pointer_node_id;
+        }
+
+        // General case.
+        else
+        {
+            // First add a node for the pointed value (recursion).
+            const uint64_t pointed_value_node_id = add_child_data_structure(*data_structure);
+
+            // Then add a simple table node for the pointer:
+            // |---------------------------|
+            // |  <Type name> |  <Address> |
+            // |---------------------------|
+            // | <Value = Pointed address> |  <--- port = "ptr"
+            // |---------------------------|
+            string_t ptr_port_name{lit(string_t, "ptr")};
+            const uint64_t pointer_node_id = impl::get_node_id_for_value(data_structure);
+            if (has_node(pointer_node_id))
+            {
+                return pointer_node_id;
+            }
+
+            auto pointer_type_name = impl::get_type_name_string<pointer_type_t, string_t>();
+            auto address_of_pointer = impl::get_address_as_string<string_t>(&data_structure);
+            auto node_for_pointer =
+                table_node<string_t>{}
+                    .with_row(std::move(pointer_type_name), std::move(address_of_pointer))
+                    .with_row(
+                        table_node<string_t>::cell::make(data_structure).spanning_columns(2).with_port(ptr_port_name));
+            node_for_pointer.set_memory_footprint(impl::make_memory_footprint(data_structure));
+            record_pointer_hop(&data_structure, data_structure);
+            add_node(pointer_node_id, std::move(node_for_pointer));
+
+            // Finally, add an edge between the two.
+            add_unique_edge(
+                arrow<string_t>{pointer_node_id, std::move(ptr_port_name), pointed_value_node_id, lit(string_t, "")});
+
+            return pointer_node_id;
+        }
+    }
+
+    // For the null pointer type.
+    uint64_t add_null_pointer()
+    {
+        if (has_node(impl::nullptr_pointer_node_id))
+        {
+            return impl::nullptr_pointer_node_id;
+        }
+
+        auto node_for_pointer = table_node<string_t>{}.with_row(lit(string_t, "nullptr"));
+        add_node(impl::nullptr_pointer_node_id, std::move(node_for_pointer));
+        return impl::nullptr_pointer_node_id;
+    }
+
+    // Special case for C-style strings.
+    template <typename cstring_type>
+    uint64_t add_cstring(const cstring_type &data_structure)
+    {
+        // Add a simple table node:
+
+        // |-------------------------|
+        // | <Type name> | <Address> |
+        // |-------------------------|
+        // |          <Value>        |
+        // |-------------------------|
+
+        const uint64_t node_id = impl::get_node_id_for_value(data_structure);
+        if (has_node(node_id))
+        {
+            return node_id;
+        }
+
+        auto type_name = impl::get_type_name_string<cstring_type, string_t>();
+        auto instance_address = impl::get_address_as_string<string_t>(&data_structure);
+        auto node_for_instance = table_node<string_t>{}
+                                     .with_row(std::move(type_name), std::move(instance_address))
+                                     .with_row(table_node<string_t>::cell::make(data_structure).spanning_columns(2));
+        node_for_instance.set_memory_footprint(impl::make_memory_footprint(data_structure));
+        add_node(node_id, std::move(node_for_instance));
+        return node_id;
+    }
+
+    bool store_node(const uint64_t node_id, std::unique_ptr<base_node<string_t>> node)
+    {
+        if (m_stream_sink != nullptr)
+        {
+            // Each node is written once. The node of a first member is not written at all: the node of its instance,
+            // built next with the same ID, replaces it as it does in m_nodes.
+            if (is_adapted_class_traversed(node_id) || !m_streamed_node_ids.insert(node_id).second)
+            {
+                return false;
+            }
+            impl::append_node_dot_string(m_stream_buffer, node_id, *node, cluster<string_t>::default_node_appearance,
+                                         m_stream_node_id_writer);
+            flush_stream_buffer();
+            return true;
+        }
+
+        const bool is_new_node = m_nodes.insert_or_assign(node_id, std::move(node)).second;
+        if (is_new_node)
+        {
+            m_node_order.emplace_back(node_id);
+        }
+        return is_new_node;
+    }
+
+    arrow<string_t> &stream_edge(const arrow<string_t> &arrow)
+    {
+        impl::append_arrow_dot_string(m_stream_buffer, arrow, m_stream_node_id_writer);
+        flush_stream_buffer();
+        m_last_streamed_edge = arrow;
+        return *m_last_streamed_edge;
+    }
+
+    // Records that the object of a node is stored inside the object or the heap memory of another node.
+    void mark_embedded_node(const uint64_t node_id)
+    {
+        // Memory usages are not available in streaming mode, which keeps as little as possible.
+        if (m_stream_sink == nullptr)
+        {
+            m_embedded_node_ids.insert(node_id);
+        }
+    }
+
+    void flush_stream_buffer()
+    {
+        // The buffer keeps its capacity: lines are formatted without reallocating.
+        *m_stream_sink << m_stream_buffer;
+        m_stream_buffer.clear();
+    }
+
+    /**
+     * Key   = node ID.
+     * Value = node instance.
+     */
+    std::unordered_map<uint64_t, std::unique_ptr<base_node<string_t>>> m_nodes;
+    /**
+     * IDs of the nodes, in the order they were added. Used to export the nodes in a deterministic order.
+     */
+    std::vector<uint64_t> m_node_order;
+    /**
+     * Key   = hash of the pair source_node_id -> destination_node_id in the connection.
+     * Value = description of the edge.
+     */
+    std::vector<arrow<string_t>> m_directed_edges;
+    std::vector<rank_constraint> m_rank_constraints;
+    /**
+     * IDs of the nodes whose object is stored inside the object or the heap memory of another node, see
+     * get_memory_usage_by_type.
+     */
+    std::unordered_set<uint64_t> m_embedded_node_ids;
+    /**
+     * IDs of the nodes of the data structures passed to add_data_structure and begin_capture, in call order.
+     */
+    std::vector<uint64_t> m_root_node_ids;
+    /**
+     * Node ID and type name of the adapted class instances whose members are being traversed, see add_adapted_class.
+     */
+    std::set<std::pair<uint64_t, const char *>> m_adapted_class_traversals;
+    /**
+     * Key   = type name, see get_locality_metrics.
+     * Value = locality of the hops to the objects of this type.
+     */
+    std::unordered_map<const char *, locality_metrics> m_locality_by_type;
+
+    size_t m_parallel_thread_count{1};
+    size_t m_parallel_elements_per_task{1024};
+
+    /**
+     * How the nodes are built. Copied as a whole to the visualizations of the parallel tasks, which must build the same
+     * nodes (see add_elements_in_parallel).
+     */
+    struct traversal_settings
+    {
+        bool is_capacity_reporting_enabled{false};
+        size_t highlighted_slack_bytes{4096};
+
+        size_t numeric_summary_min_length{0};
+        size_t numeric_summary_bin_count{16};
+
+        size_t matrix_grid_size{0};
+        matrix_pooling matrix_cell_pooling{matrix_pooling::mean};
+
+        bool is_hash_table_health_enabled{false};
+        size_t max_displayed_key_value_elements{0};
+
+        /**
+         * Address ranges drawn as clusters, see add_memory_arena.
+         */
+        std::vector<memory_arena<string_t>> memory_arenas;
+        /**
+         * Key   = address of a memory resource.
+         * Value = its name, see name_memory_resource.
+         */
+        std::unordered_map<const void *, string_t> memory_resource_names;
+    };
+    traversal_settings m_settings;
+
+    /**
+     * Stack of the traversals remaining in the current capture (see begin_capture).
+     */
+    std::vector<std::function<void()>> m_pending_captures;
+    /**
+     * Traversals deferred while building the current node of a capture step.
+     */
+    std::vector<std::function<void()>> m_deferred_captures;
+    std::function<uint64_t()> m_capture_version_probe;
+    uint64_t m_capture_version{0};
+    std::chrono::steady_clock::duration m_average_capture_duration{0};
+    bool m_is_capture_step_running{false};
+
+    /**
+     * Sink of the streaming mode, nullptr when not streaming (see begin_streaming).
+     */
+    std::basic_ostream<typename string_t::value_type> *m_stream_sink{nullptr};
+    /**
+     * IDs of the nodes written to the sink. Replaces m_nodes in streaming mode.
+     */
+    std::unordered_set<uint64_t> m_streamed_node_ids;
+    string_t m_stream_buffer;
+    impl::node_id_writer<string_t> m_stream_node_id_writer;
+    std::optional<arrow<string_t>> m_last_streamed_edge;
+
+    friend string_t generate_dot_visualization_string<string_t>(const visualization<string_t> &,
+                                                                const dot_export_options &);
+    friend string_t generate_svg_visualization_string<string_t>(const visualization<string_t> &,
+                                                                const svg_export_options &);
+};
+
+// ------------------------------------------- graphviz generation ------------------------------------------ //
+
+namespace impl
+{
+template <typename string_t>
+[[nodiscard]] string_t generate_cluster_style_string(const cluster<string_t> cluster)
+{
+    string_t result;
+    if (cluster.style != cluster_style::normal)
+    {
+        constexpr size_t max_result_length = 15; // "style=striped;\0"  => 15 chars
+        result.reserve(max_result_length);
+        result += lit(string_t, "style=");
+        result += get_cluster_style_name<string_t>(cluster.style);
+        result += lit(string_t, ";\n");
+    }
+    return result;
+}
+
+template <typename string_t>
+[[nodiscard]] string_t generate_cluster_color_string(const cluster<string_t> cluster)
+{
+    string_t result;
+    if (!cluster.cluster_color.empty())
+    {
+        const size_t result_length = 8 + cluster.cluster_color.size(); // "color=<color>;\0"  => 8 + len(<color>) chars
+        result.reserve(result_length);
+        result += lit(string_t, "color=");
+        result += cluster.cluster_color;
+        result += lit(string_t, ";\n");
+    }
+    return result;
+}
+
+template <typename string_t>
+[[nodiscard]] string_t generate_cluster_label_string(const cluster<string_t> cluster)
+{
+    string_t result;
+    if (!cluster.cluster_label.empty())
+    {
+        const size_t result_length = 8 + cluster.cluster_label.size(); // "label=<label>;\0"  => 8 + len(<label>) chars
+        result.reserve(result_length);
+        result += lit(string_t, "label=");
+        result += cluster.cluster_label;
+        result += lit(string_t, ";\n");
+    }
+    return result;
+}
+
+template <typename string_t>
+[[nodiscard]] string_t generate_default_node_appearance_string(const cluster<string_t> cluster)
+{
+    string_t result;
+    result += lit(string_t, "node[");
+    result += generate_node_appearance_string(
+        cluster.default_node_appearance,
+        node_appearance<string_t>{}); // Default-constructed values won't generate any appearance information.
+    result += lit(string_t, "]\n");
+    return result;
+}
+
+template <typename string_t>
+[[nodiscard]] string_t generate_node_appearance_string(const node_appearance<string_t> &appearance,
+                                                       const node_appearance<string_t> &default_node_appearance)
+{
+    // Override default appearance for the different visual parameters.
+    // Don't write anything if the settings are the same as the current default,
+    // to reduce output size as much as possible.
+
+    string_t result; // TODO: optim: reserve
+
+    if (appearance.shape != default_node_appearance.shape)
     {
-        m_directed_edges.emplace_back(std::move(arrow));
-        return m_directed_edges[m_directed_edges.size() - 1];
+        result += lit(string_t, "shape=");
+        result += get_node_shape_name<string_t>(appearance.shape);
+        result += lit(string_t, ",");
     }
 
-    std::optional<std::reference_wrapper<arrow<string_t>>> add_unique_edge(const arrow<string_t> &arrow)
+    if (appearance.style != default_node_appearance.style)
     {
-        const auto iterator = std::find(m_directed_edges.cbegin(), m_directed_edges.cend(), arrow);
-        if (iterator != m_directed_edges.end())
+        result += lit(string_t, "style=");
+        result += get_node_style_name<string_t>(appearance.style);
+        result += lit(string_t, ",");
+    }
+
+    if (appearance.color != default_node_appearance.color)
+    {
+        result += lit(string_t, "color=");
+        result += appearance.color;
+        result += lit(string_t, ",");
+    }
+
+    return result;
+}
+
+template <typename string_t>
+[[nodiscard]] string_t generate_table_node_cell_html(const typename table_node<string_t>::cell &cell)
+{
+    string_t result = generate_table_node_cell_opening_html<string_t>(cell);
+
+    // 2. The value in the cell.
+    result += cell.value;
+
+    // 3. Close the cell.
+    result += lit(string_t, "</td>");
+    return result;
+}
+
+template <typename string_t>
+[[nodiscard]] string_t generate_table_node_cell_opening_html(const typename table_node<string_t>::cell &cell)
+{
+    string_t result; // TODO: optim: reserve
+
+    // 1. Open the cell and fill its parameters.
+    result += lit(string_t, "<td ");
+
+    // Generate ' rowspan="<value>"' if non-default span.
+    if (cell.row_span != cell.default_row_span)
+    {
+        result += lit(string_t, " rowspan=\"");
+        result += cdv::to_string<string_t>(cell.row_span);
+        result += lit(string_t, "\"");
+    }
+    // Generate ' colspan="<value>"' if non-default span.
+    if (cell.column_span != cell.default_column_span)
+    {
+        result += lit(string_t, " colspan=\"");
+        result += cdv::to_string<string_t>(cell.column_span);
+        result += lit(string_t, "\"");
+    }
+    // Generate ' port="<value>"' if a port is specified for this cell.
+    if (!cell.port_name.empty())
+    {
+        result += lit(string_t, " port=\"");
+        result += cell.port_name;
+        result += lit(string_t, "\"");
+    }
+    // Generate ' bgcolor="<value>"' if the cell is highlighted.
+    if (!cell.background_color.empty())
+    {
+        result += lit(string_t, " bgcolor=\"");
+        result += cell.background_color;
+        result += lit(string_t, "\"");
+    }
+
+    result += lit(string_t, ">");
+    return result;
+}
+
+template <typename string_t>
+void append_graph_header_dot_string(string_t &result, const cluster<string_t> &graph)
+{
+    result += lit(string_t, "digraph G {\n");
+    result += generate_cluster_color_string(graph);
+    result += generate_cluster_label_string(graph);
+    result += generate_cluster_style_string(graph);
+    result += generate_default_node_appearance_string(graph);
+}
+
+template <typename string_t>
+void append_node_dot_string(string_t &result, const uint64_t node_id, const base_node<string_t> &node,
+                            const node_appearance<string_t> &default_node_appearance,
+                            node_id_writer<string_t> &node_id_writer)
+{
+    // Each graphviz node is uniquely identified by this ID. Used later for edges.
+    node_id_writer.append(result, node_id);
+    // Actual content of the nodes.
+    result += node.generate_structure_string(default_node_appearance);
+    // One node per line.
+    result += new_line<string_t>();
+}
+
+template <typename string_t>
+void append_arrow_dot_string(string_t &result, const arrow<string_t> &arrow, node_id_writer<string_t> &node_id_writer)
+{
+    // Source node with port if specified.
+    node_id_writer.append(result, arrow.source_node_id);
+    if (!arrow.source_port.empty())
+    {
+        result += lit(string_t, ":");
+        result += cdv::to_string<string_t>(arrow.source_port);
+    }
+
+    // The arrow.
+    result += lit(string_t, " -> ");
+
+    // Destination node with port if specified.
+    node_id_writer.append(result, arrow.destination_node_id);
+    if (!arrow.destination_port.empty())
+    {
+        result += lit(string_t, ":");
+        result += cdv::to_string<string_t>(arrow.destination_port);
+    }
+
+    // Arrow shape / style.
+    result += lit(string_t, "[");
+    if (arrow.shape != arrow_shape::normal)
+    {
+        result += lit(string_t, "shape");
+        result += lit(string_t, "=");
+        result += cdv::get_arrow_shape_name<string_t>(arrow.shape);
+        result += lit(string_t, ","); // Trailing commas are allowed in the graphviz grammar.
+    }
+    if (arrow.style != edge_style::normal)
+    {
+        result += lit(string_t, "style");
+        result += lit(string_t, "=");
+        result += cdv::get_edge_style_name<string_t>(arrow.style);
+        result += lit(string_t, ","); // Trailing commas are allowed in the graphviz grammar.
+    }
+    result += lit(string_t, "]\n");
+}
+
+template <typename string_t>
+void append_graph_footer_dot_string(string_t &result, const std::vector<rank_constraint> &rank_constraints,
+                                    node_id_writer<string_t> &node_id_writer)
+{
+    // Rank constraints.
+    for (const rank_constraint &constraint : rank_constraints)
+    {
+        if (!constraint.constrained_node_ids.empty())
         {
-            return std::nullopt;
+            result += lit(string_t, "{rank=same;");
+            for (const auto node_id : constraint.constrained_node_ids)
+            {
+                node_id_writer.append(result, node_id);
+                result += lit(string_t, ";");
+            }
+            result += lit(string_t, "}");
         }
-        m_directed_edges.emplace_back(arrow);
-        return m_directed_edges[m_directed_edges.size() - 1];
     }
 
-    void add_rank_constraint(const rank_constraint &constraint)
+    // Close the graph !
+    result += lit(string_t, "}\n");
+}
+} // namespace impl
+
+template <typename string_t>
+[[nodiscard]] string_t generate_dot_visualization_string(const visualization<string_t> &visualization,
+                                                         const dot_export_options &options)
+{
+    string_t result;
+    constexpr size_t estimated_characters_per_node = 1000; // TODO: find an actual estimation, this number is BS.
+    result.reserve(visualization.m_nodes.size() * estimated_characters_per_node);
+
+    // Sequential node IDs follow the traversal order, as the nodes are written first.
+    impl::node_id_writer<string_t> node_id_writer{options.node_ids};
+    node_id_writer.reserve(visualization.m_nodes.size());
+
+    // 1. Graph setup, with all the cluster information of the global graph
+    // (the global graph itself is a cluster).
+    impl::append_graph_header_dot_string(result, visualization);
+
+    // Summarized nodes are replaced by the node summarizing them, written in place of its first node.
+    // Identical nodes are written once, in place of the first one.
+    const bool is_summarized = options.collapsed_component_min_size > 0 || options.folded_chain_min_length > 0 ||
+                               options.merge_identical_subgraphs;
+    const auto summary = is_summarized ? visualization.summarize_graph(options)
+                                       : typename cdv::visualization<string_t>::graph_summary{};
+
+    // 2. Print each node's structure, ie actual node content, in a cluster per memory region if requested.
+    const auto append_node = [&](const uint64_t node_id) {
+        if (const auto summarized = summary.summary_node_ids.find(node_id);
+            summarized != summary.summary_node_ids.end())
+        {
+            if (summarized->second == node_id)
+            {
+                impl::append_node_dot_string(result, node_id, summary.summary_nodes.find(node_id)->second,
+                                             visualization.default_node_appearance, node_id_writer);
+            }
+            return;
+        }
+        if (summary.identical_node_ids.count(node_id) != 0)
+        {
+            return;
+        }
+        const auto &node = visualization.m_nodes.find(node_id)->second;
+        impl::append_node_dot_string(result, node_id, *node, visualization.default_node_appearance, node_id_writer);
+    };
+    if (options.memory_regions == memory_region_grouping::none)
     {
-        m_rank_constraints.emplace_back(constraint);
+        std::for_each(visualization.m_node_order.begin(), visualization.m_node_order.end(), append_node);
+    }
+    else
+    {
+        std::vector<uint64_t> ungrouped_node_ids;
+        const auto regions = visualization.group_nodes_by_memory_region(options.memory_regions, ungrouped_node_ids);
+        std::for_each(ungrouped_node_ids.begin(), ungrouped_node_ids.end(), append_node);
+        for (size_t region_index = 0; region_index < regions.size(); ++region_index)
+        {
+            result += lit(string_t, "subgraph cluster_");
+            result += cdv::to_string<string_t>(region_index);
+            result += lit(string_t, " {\n");
+            result += impl::generate_cluster_color_string(regions[region_index].appearance);
+            result += impl::generate_cluster_label_string(regions[region_index].appearance);
+            result += impl::generate_cluster_style_string(regions[region_index].appearance);
+            std::for_each(regions[region_index].node_ids.begin(), regions[region_index].node_ids.end(), append_node);
+            result += lit(string_t, "}\n");
+        }
+    }
+    if (options.highlight_false_sharing)
+    {
+        for (const uint64_t node_id : visualization.find_false_sharing_candidates())
+        {
+            if (summary.summary_node_ids.count(node_id) == 0 && summary.identical_node_ids.count(node_id) == 0)
+            {
+                node_id_writer.append(result, node_id);
+                result += lit(string_t, "[color=red]\n");
+            }
+        }
+    }
+    for (const uint64_t node_id : visualization.m_node_order)
+    {
+        if (const auto count = summary.identical_node_counts.find(node_id);
+            count != summary.identical_node_counts.end())
+        {
+            node_id_writer.append(result, node_id);
+            result += lit(string_t, "[xlabel=<&times;");
+            result += cdv::to_string<string_t>(count->second);
+            result += lit(string_t, ">]\n");
+        }
     }
 
-    void add_rank_constraint(rank_constraint &&constraint)
+    // 3. Print each arrow / directed edge between nodes. The edges of summarized nodes go to or from the node
+    // summarizing them, without port. The edges of identical nodes go to or from the first one, with their port. Each
+    // of these edges is written once.
+    if (summary.is_empty())
     {
-        m_rank_constraints.emplace_back(std::move(constraint));
+        for (const auto &arrow : visualization.m_directed_edges)
+        {
+            impl::append_arrow_dot_string(result, arrow, node_id_writer);
+        }
     }
+    else
+    {
+        std::set<std::tuple<uint64_t, string_t, uint64_t, string_t, edge_style>> summary_edges;
+        for (const auto &arrow : visualization.m_directed_edges)
+        {
+            auto summary_edge = arrow;
+            for (const bool is_source : {true, false})
+            {
+                uint64_t &node_id = is_source ? summary_edge.source_node_id : summary_edge.destination_node_id;
+                string_t &port = is_source ? summary_edge.source_port : summary_edge.destination_port;
+                if (const uint64_t summary_node_id = summary.get_node_id(node_id); summary_node_id != node_id)
+                {
+                    node_id = summary_node_id;
+                    port.clear();
+                }
+                else if (const auto identical = summary.identical_node_ids.find(node_id);
+                         identical != summary.identical_node_ids.end())
+                {
+                    node_id = identical->second;
+                }
+            }
 
-    // Advanced automatic data structure visualization functions.
+            const bool is_inside_summary_node =
+                summary_edge.source_node_id == summary_edge.destination_node_id && !(summary_edge == arrow);
+            if (!is_inside_summary_node &&
+                summary_edges
+                    .emplace(summary_edge.source_node_id, summary_edge.source_port, summary_edge.destination_node_id,
+                             summary_edge.destination_port, summary_edge.style)
+                    .second)
+            {
+                impl::append_arrow_dot_string(result, summary_edge, node_id_writer);
+            }
+        }
+    }
 
-    // For known linear containers, ie containers that contain values that can be iterated over,
-    // as opposed to key-value containers that also contain keys.
-    template <typename linear_container_t>
-    uint64_t add_data_structure(const linear_container_t &container,
-                                std::enable_if_t<traits::is_linear_container_v<linear_container_t>, bool> = true)
+    // 4. TODO: print each undirected edge.
+
+    // 5. Rank constraints, and close the graph !
+    if (summary.is_empty())
     {
-        using value_t = typename linear_container_t::value_type;
+        impl::append_graph_footer_dot_string(result, visualization.m_rank_constraints, node_id_writer);
+    }
+    else
+    {
+        std::vector<rank_constraint> rank_constraints = visualization.m_rank_constraints;
+        for (rank_constraint &constraint : rank_constraints)
+        {
+            for (uint64_t &node_id : constraint.constrained_node_ids)
+            {
+                const auto identical = summary.identical_node_ids.find(node_id);
+                node_id = identical != summary.identical_node_ids.end() ? identical->second
+                                                                        : summary.get_node_id(node_id);
+            }
+        }
+        impl::append_graph_footer_dot_string(result, rank_constraints, node_id_writer);
+    }
 
-        // |--------------------------------------------|
-        // | <Type name> | <Address> | Length: <Length> |
-        // |--------------------------------------------|
-        // | <Val 1> | <Val 2> | <Val 3> | ............ |
-        // |--------------------------------------------|
+    return result;
+}
+
+// --------------------------------------------- svg generation --------------------------------------------- //
+
+namespace impl
+{
+/**
+ * Sugiyama-style layered layout of a directed graph whose vertices are boxes, see generate_svg_visualization_string:
+ * 1. cycles are broken by reversing the back edges of a depth-first search,
+ * 2. vertices are ranked by longest path from the sources, then each source is moved down next to its successors,
+ * 3. edges spanning several ranks go through a dummy vertex in each rank they cross, up to a maximum span,
+ * 4. the vertices of each rank are ordered by barycenter sweeps, keeping the order with the fewest crossings,
+ * 5. vertices are placed as close as possible to their neighbours without overlapping, and ranks below each other.
+ * Each step is linear in the number of vertices and edges (dummy vertices included), up to the sorts and the log factor
+ * of counting crossings. The number of crossing reduction sweeps is bounded by a time budget.
+ */
+class layered_layout
+{
+  public:
+    struct edge
+    {
+        size_t source{0};
+        size_t destination{0};
+        // Horizontal position of the ends of the edge (ports), relative to the center of their vertex.
+        double source_offset{0.0};
+        double destination_offset{0.0};
+    };
+
+    struct point
+    {
+        double x{0.0};
+        double y{0.0};
+    };
+
+    /**
+     * \param widths, heights Size of each vertex.
+     * \param edges Edges between the vertices, without self loops.
+     */
+    layered_layout(std::vector<double> widths, std::vector<double> heights, std::vector<edge> edges)
+        : m_vertex_count{widths.size()}
+        , m_widths{std::move(widths)}
+        , m_heights{std::move(heights)}
+        , m_edges{std::move(edges)}
+    {
+    }
+
+    void run(const svg_export_options &options)
+    {
+        break_cycles();
+        assign_ranks();
+        add_dummy_vertices(options.max_routed_edge_span);
+        order_ranks(options);
+        assign_coordinates(options);
+        route_edges();
+    }
+
+    /**
+     * \return The center of a vertex.
+     */
+    [[nodiscard]] point get_center(const size_t vertex) const
+    {
+        return {m_x[vertex], m_y[vertex]};
+    }
+
+    /**
+     * \return The points of the polyline drawing an edge, from its source to its destination.
+     */
+    [[nodiscard]] const std::vector<point> &get_route(const size_t edge_index) const
+    {
+        return m_routes[edge_index];
+    }
+
+    [[nodiscard]] double get_width() const
+    {
+        return m_width;
+    }
+
+    [[nodiscard]] double get_height() const
+    {
+        return m_height;
+    }
+
+    /**
+     * \return The number of crossings between the edges of consecutive ranks in the final order.
+     */
+    [[nodiscard]] size_t get_crossing_count() const
+    {
+        return m_crossing_count;
+    }
+
+  private:
+    // Part of an edge between two consecutive ranks.
+    struct segment
+    {
+        size_t upper{0};
+        size_t lower{0};
+        double upper_offset{0.0};
+        double lower_offset{0.0};
+    };
 
-        const uint64_t container_node_id = impl::get_node_id_for_value(container);
-        if (has_node(container_node_id))
+    // Adjacency lists in compressed form: the neighbours of vertex v are items[first[v]] to items[first[v + 1]].
+    struct adjacency
+    {
+        std::vector<size_t> first;
+        std::vector<size_t> items;
+
+        template <typename get_vertex_t>
+        void build(const size_t vertex_count, const size_t item_count, get_vertex_t get_vertex)
         {
-            return container_node_id;
+            first.assign(vertex_count + 1, 0);
+            for (size_t item = 0; item < item_count; ++item)
+            {
+                ++first[get_vertex(item) + 1];
+            }
+            std::partial_sum(first.begin(), first.end(), first.begin());
+            items.resize(item_count);
+            std::vector<size_t> next(first.begin(), first.end() - 1);
+            for (size_t item = 0; item < item_count; ++item)
+            {
+                items[next[get_vertex(item)]++] = item;
+            }
         }
+    };
 
-        auto type_name = impl::get_type_name_string<linear_container_t, string_t>();
-        auto instance_address = impl::get_address_as_string<string_t>(&container);
-        // Use std::distance, because some containers don't have a size (std::forward_list is one).
-        const auto length = std::distance(container.cbegin(), container.cend());
-        auto length_str = string_t{lit(string_t, "Length: ")} + to_string<string_t>(length);
-        auto container_node = table_node<string_t>{}.with_row(cell_t{std::move(type_name)}.spanning_columns(4),
-                                                              cell_t{std::move(instance_address)}.spanning_columns(2),
-                                                              cell_t{std::move(length_str)}.spanning_columns(2));
+    [[nodiscard]] size_t get_upper_vertex(const size_t edge_index) const
+    {
+        return m_is_reversed[edge_index] ? m_edges[edge_index].destination : m_edges[edge_index].source;
+    }
 
-        constexpr member_display_type data_display_type = impl::get_data_display_type<value_t>();
+    [[nodiscard]] size_t get_lower_vertex(const size_t edge_index) const
+    {
+        return m_is_reversed[edge_index] ? m_edges[edge_index].source : m_edges[edge_index].destination;
+    }
 
-        // Put the value directly in each cell.
-        if constexpr (data_display_type == member_display_type::inside)
+    void break_cycles()
+    {
+        m_is_reversed.assign(m_edges.size(), false);
+        adjacency out_edges;
+        out_edges.build(m_vertex_count, m_edges.size(), [this](const size_t edge) { return m_edges[edge].source; });
+
+        // Starting from the sources first keeps the edges going away from the roots of the data structures. Cycles
+        // without sources are entered from their last vertex: nodes are added in post-order, after the nodes they lead
+        // to, so the last one is the root of the traversal.
+        std::vector<size_t> in_degrees(m_vertex_count, 0);
+        for (const edge &edge : m_edges)
         {
-            auto values_row = typename table_node<string_t>::row{};
-            values_row.cells.emplace_back(lit(string_t, "Values: "));
-            for (const auto &value : container)
+            ++in_degrees[edge.destination];
+        }
+        std::vector<size_t> starts;
+        starts.reserve(m_vertex_count);
+        for (size_t vertex = 0; vertex < m_vertex_count; ++vertex)
+        {
+            if (in_degrees[vertex] == 0)
             {
-                values_row.cells.emplace_back(cdv::to_string<string_t>(value));
+                starts.push_back(vertex);
             }
-            container_node.add_row(values_row);
         }
-        // value_t is a pointer type:
-        // - put the ADDRESS in each cell,
-        // - add a node for each pointed value,
-        // - add an edge to each node
-        else if constexpr (data_display_type == member_display_type::pointer_edge)
+        for (size_t vertex = m_vertex_count; vertex-- > 0;)
         {
-            auto values_row = typename table_node<string_t>::row{};
-            values_row.cells.emplace_back(lit(string_t, "Values: "));
-            size_t index = 0;
-            for (const auto &value : container)
+            if (in_degrees[vertex] != 0)
             {
-                // Address in the vector node.
-                const auto port_name = cdv::to_string<string_t>(index);
-                values_row.cells.emplace_back(
-                    cell_t{impl::get_address_as_string<string_t>(value)}.with_port(port_name));
-
-                // Node for the value.
-                const uint64_t pointed_node_id = add_data_structure(*value);
-
-                // Edge from the cell to the value.
-                add_edge(arrow<string_t>{container_node_id, port_name, pointed_node_id, lit(string_t, "")});
-                ++index;
+                starts.push_back(vertex);
             }
-            container_node.add_row(values_row);
         }
-        // value_t is an adapted type:
-        // - put the INDEX in each cell,
-        // - add a node for each value,
-        // - add an edge to each node
-        else if constexpr (data_display_type == member_display_type::composition_edge)
+
+        // Iterative depth-first search: an edge to a vertex still on the stack closes a cycle, and is reversed.
+        enum class state : uint8_t
         {
-            auto values_row = typename table_node<string_t>::row{};
-            values_row.cells.emplace_back(lit(string_t, "Values: "));
-            size_t index = 0;
-            for (const auto &value : container)
+            unvisited,
+            on_stack,
+            done
+        };
+        std::vector<state> states(m_vertex_count, state::unvisited);
+        std::vector<std::pair<size_t, size_t>> stack; // Vertex, position of its next out edge.
+        for (const size_t start : starts)
+        {
+            if (states[start] != state::unvisited)
             {
-                // Index in the vector node.
-                const auto port_name = cdv::to_string<string_t>(index);
-                values_row.cells.emplace_back(cell_t{cdv::to_string<string_t>(index)}.with_port(port_name));
-
-                // Node for the value.
-                const uint64_t contained_node_id = add_data_structure(value);
-
-                // Edge from the cell to the value.
-                add_edge(arrow<string_t>{container_node_id, port_name, contained_node_id, lit(string_t, "")}.with_style(
-                    edge_style::dashed));
-                ++index;
+                continue;
+            }
+            states[start] = state::on_stack;
+            stack.emplace_back(start, out_edges.first[start]);
+            while (!stack.empty())
+            {
+                auto &[vertex, next] = stack.back();
+                if (next == out_edges.first[vertex + 1])
+                {
+                    states[vertex] = state::done;
+                    stack.pop_back();
+                    continue;
+                }
+                const size_t edge_index = out_edges.items[next++];
+                const size_t destination = m_edges[edge_index].destination;
+                if (states[destination] == state::on_stack)
+                {
+                    m_is_reversed[edge_index] = true;
+                }
+                else if (states[destination] == state::unvisited)
+                {
+                    states[destination] = state::on_stack;
+                    stack.emplace_back(destination, out_edges.first[destination]);
+                }
             }
-            container_node.add_row(values_row);
         }
-
-        // todo std::reference_wrapper
-
-        add_node(container_node_id, std::move(container_node));
-        return container_node_id;
     }
 
-    template <typename adapted_class_t, size_t member_index>
-    void add_rows_for_members(const adapted_class_t &data_structure, [[maybe_unused]] const uint64_t instance_node_id,
-                              table_node<string_t> &node_for_data_structure)
+    void assign_ranks()
     {
-        // indexed_member_access_t::get_member_name()  : unit -> string_t
-        // indexed_member_access_t::get_member_value() : const adapted_class_t& instance -> auto
-        // indexed_member_access_t::display_member()   : const adapted_class_t& instance -> bool
-        using indexed_member_access_t = traits::access<adapted_class_t, member_index>;
-
-        // 1. Add a new row for the current member.
-        if (indexed_member_access_t::display_member(data_structure))
+        adjacency lower_edges;
+        lower_edges.build(m_vertex_count, m_edges.size(), [this](const size_t edge) { return get_upper_vertex(edge); });
+        std::vector<size_t> in_degrees(m_vertex_count, 0);
+        for (size_t edge_index = 0; edge_index < m_edges.size(); ++edge_index)
         {
-            auto member_name = indexed_member_access_t::get_member_name();
-            const auto &member_value = indexed_member_access_t::get_member_value(data_structure);
-            constexpr member_display_type data_display_type =
-                impl::get_data_display_type<decltype(indexed_member_access_t::get_member_value(data_structure))>();
+            ++in_degrees[get_lower_vertex(edge_index)];
+        }
 
-            if constexpr (data_display_type == member_display_type::inside)
+        // Longest path from the sources, in topological order.
+        m_ranks.assign(m_vertex_count, 0);
+        std::vector<size_t> topological_order;
+        topological_order.reserve(m_vertex_count);
+        std::vector<size_t> remaining_in_degrees = in_degrees;
+        for (size_t vertex = 0; vertex < m_vertex_count; ++vertex)
+        {
+            if (in_degrees[vertex] == 0)
             {
-                const auto port_name = cdv::to_string<string_t>(member_index);
-                node_for_data_structure.add_row(std::move(member_name),
-                                                cell_t{cdv::to_string<string_t>(member_value)}.with_port(port_name));
+                topological_order.push_back(vertex);
             }
-            else if constexpr (data_display_type == member_display_type::composition_edge)
+        }
+        for (size_t position = 0; position < topological_order.size(); ++position)
+        {
+            const size_t vertex = topological_order[position];
+            for (size_t item = lower_edges.first[vertex]; item < lower_edges.first[vertex + 1]; ++item)
             {
-                // Address in the instance table.
-                const auto port_name = cdv::to_string<string_t>(member_index);
-                node_for_data_structure.add_row(
-                    std::move(member_name),
-                    cell_t{impl::get_address_as_string<string_t>(&member_value)}.with_port(port_name));
-
-                // Node for the value.
-                const uint64_t pointed_node_id = add_data_structure(member_value);
-
-                // Edge from the cell to the value.
-                // TODO add_rows_for_members | proper arrow shape for 'composition_edge'
-                add_edge(arrow<string_t>{instance_node_id, port_name, pointed_node_id, lit(string_t, "")}.with_style(
-                    edge_style::dashed));
-            }
-            else // member_display_method == member_display_type::pointer_edge
-            {
-                // Address in the instance table.
-                const auto port_name = cdv::to_string<string_t>(member_index);
-                node_for_data_structure.add_row(
-                    std::move(member_name),
-                    cell_t{impl::get_address_as_string<string_t>(member_value)}.with_port(port_name));
-                if (member_value != nullptr)
+                const size_t lower = get_lower_vertex(lower_edges.items[item]);
+                m_ranks[lower] = std::max(m_ranks[lower], m_ranks[vertex] + 1);
+                if (--remaining_in_degrees[lower] == 0)
                 {
-                    // Node for the pointed value.
-                    const uint64_t pointed_node_id = add_data_structure(*member_value);
-                    // Edge from the cell to the value.
-                    // TODO add_rows_for_members | proper arrow shape for 'pointer_edge'
-                    add_edge(arrow<string_t>{instance_node_id, port_name, pointed_node_id, lit(string_t, "")});
+                    topological_order.push_back(lower);
                 }
             }
         }
 
-        // 2. Recursion to display the next adapted member, if there's one.
-        if constexpr (traits::access<adapted_class_t, member_index + 1>::value)
+        // A source pointing to deep vertices only would otherwise stay at the top, with long edges down.
+        for (auto vertex = topological_order.rbegin(); vertex != topological_order.rend(); ++vertex)
         {
-            add_rows_for_members<adapted_class_t, member_index + 1>(data_structure, instance_node_id,
-                                                                    node_for_data_structure);
+            if (in_degrees[*vertex] == 0 && lower_edges.first[*vertex] != lower_edges.first[*vertex + 1])
+            {
+                size_t min_lower_rank = std::numeric_limits<size_t>::max();
+                for (size_t item = lower_edges.first[*vertex]; item < lower_edges.first[*vertex + 1]; ++item)
+                {
+                    min_lower_rank = std::min(min_lower_rank, m_ranks[get_lower_vertex(lower_edges.items[item])]);
+                }
+                m_ranks[*vertex] = min_lower_rank - 1;
+            }
         }
     }
 
-    // For custom user types.
-    template <typename adapted_class_t>
-    uint64_t add_data_structure(const adapted_class_t &data_structure,
-                                std::enable_if_t<traits::is_adapted_v<adapted_class_t>, bool> = true)
+    void add_dummy_vertices(const size_t max_routed_edge_span)
     {
-        // Add a table node referencing all adapted members :
-
-        // |-------------------------------------|
-        // |   <Type name>    |    <Address>     |
-        // |-------------------------------------|
-        // | <Member Name 1>  | <Member Value 1> |
-        // |-------------------------------------|
-        // | <Member Name 2>  | <Member Value 2> |
-        // |-------------------------------------|
-        // |             	...             	 |
-        // |-------------------------------------|
-
-        const uint64_t node_id = impl::get_node_id_for_value(data_structure);
-        if (has_node(node_id))
+        m_chain_first.reserve(m_edges.size() + 1);
+        for (size_t edge_index = 0; edge_index < m_edges.size(); ++edge_index)
         {
-            return node_id;
+            const edge &edge = m_edges[edge_index];
+            const size_t upper = get_upper_vertex(edge_index);
+            const size_t lower = get_lower_vertex(edge_index);
+            const double upper_offset = m_is_reversed[edge_index] ? edge.destination_offset : edge.source_offset;
+            const double lower_offset = m_is_reversed[edge_index] ? edge.source_offset : edge.destination_offset;
+
+            // Chain of vertices from the upper end to the lower end, one per rank.
+            m_chain_first.push_back(m_chains.size());
+            m_chains.push_back(upper);
+            if (m_ranks[lower] - m_ranks[upper] > max_routed_edge_span)
+            {
+                // Drawn straight, out of the ranks.
+                m_chains.push_back(lower);
+                continue;
+            }
+            double segment_upper_offset = upper_offset;
+            for (size_t rank = m_ranks[upper] + 1; rank < m_ranks[lower]; ++rank)
+            {
+                const size_t dummy = m_widths.size();
+                m_widths.push_back(0.0);
+                m_heights.push_back(0.0);
+                m_ranks.push_back(rank);
+                m_segments.push_back({m_chains.back(), dummy, segment_upper_offset, 0.0});
+                m_chains.push_back(dummy);
+                segment_upper_offset = 0.0;
+            }
+            m_segments.push_back({m_chains.back(), lower, segment_upper_offset, lower_offset});
+            m_chains.push_back(lower);
         }
-
-        auto type_name = impl::get_type_name_string<adapted_class_t, string_t>();
-        auto instance_address = impl::get_address_as_string<string_t>(&data_structure);
-        // Base node with heading row.
-        auto node_for_instance = table_node<string_t>{}.with_row(std::move(type_name), std::move(instance_address));
-
-        // Loop over adapted members.
-        add_rows_for_members<adapted_class_t, 0>(data_structure, node_id, node_for_instance);
-        add_node(node_id, std::move(node_for_instance));
-        return node_id;
+        m_chain_first.push_back(m_chains.size());
+
+        const size_t vertex_count = m_widths.size();
+        m_upper_segments.build(vertex_count, m_segments.size(), [this](const size_t item) {
+            return m_segments[item].lower;
+        });
+        m_lower_segments.build(vertex_count, m_segments.size(), [this](const size_t item) {
+            return m_segments[item].upper;
+        });
     }
 
-    // For simple types.
-    template <typename simple_type_t>
-    uint64_t add_data_structure(const simple_type_t &data_structure,
-                                std::enable_if_t<impl::is_simple_type_v<simple_type_t>, bool> = true)
+    // Initial order: depth-first from the sources, which keeps the subtrees of a data structure together.
+    void make_initial_order()
     {
-        // Add a simple table node:
+        const size_t vertex_count = m_widths.size();
+        const size_t rank_count = vertex_count == 0 ? 0 : *std::max_element(m_ranks.begin(), m_ranks.end()) + 1;
+        m_layers.assign(rank_count, {});
+        m_positions.assign(vertex_count, 0);
+
+        std::vector<bool> is_placed(vertex_count, false);
+        std::vector<std::pair<size_t, size_t>> stack; // Vertex, position of its next lower segment.
+        const auto place = [&](const size_t vertex) {
+            is_placed[vertex] = true;
+            m_positions[vertex] = m_layers[m_ranks[vertex]].size();
+            m_layers[m_ranks[vertex]].push_back(vertex);
+            stack.emplace_back(vertex, m_lower_segments.first[vertex]);
+        };
+        for (const bool is_source : {true, false})
+        {
+            for (size_t vertex = 0; vertex < vertex_count; ++vertex)
+            {
+                const bool has_upper_segments = m_upper_segments.first[vertex] != m_upper_segments.first[vertex + 1];
+                if (is_placed[vertex] || has_upper_segments == is_source)
+                {
+                    continue;
+                }
+                place(vertex);
+                while (!stack.empty())
+                {
+                    auto &[current, next] = stack.back();
+                    if (next == m_lower_segments.first[current + 1])
+                    {
+                        stack.pop_back();
+                        continue;
+                    }
+                    const size_t lower = m_segments[m_lower_segments.items[next++]].lower;
+                    if (!is_placed[lower])
+                    {
+                        place(lower);
+                    }
+                }
+            }
+        }
+    }
 
-        // |-------------------------|
-        // | <Type name> | <Address> |
-        // |-------------------------|
-        // |     	  <Value>        |
-        // |-------------------------|
+    // Position of the end of a segment in the order of its rank, with the port as a fraction of the vertex.
+    [[nodiscard]] double get_ordering_position(const size_t vertex, const double offset) const
+    {
+        const double width = m_widths[vertex];
+        const double fraction = width > 0.0 ? std::clamp(offset / width + 0.5, 0.0, 0.99) : 0.5;
+        return static_cast<double>(m_positions[vertex]) + fraction;
+    }
 
-        const uint64_t node_id = impl::get_node_id_for_value(data_structure);
-        if (has_node(node_id))
+    // Sorts a rank by the barycenter of the neighbours of its vertices in the previous rank of the sweep.
+    void reorder_rank(const size_t rank, const bool is_downward_sweep, std::vector<double> &barycenters)
+    {
+        std::vector<size_t> &layer = m_layers[rank];
+        const adjacency &neighbours = is_downward_sweep ? m_upper_segments : m_lower_segments;
+        for (const size_t vertex : layer)
         {
-            return node_id;
+            double sum = 0.0;
+            for (size_t item = neighbours.first[vertex]; item < neighbours.first[vertex + 1]; ++item)
+            {
+                const segment &segment = m_segments[neighbours.items[item]];
+                sum += is_downward_sweep ? get_ordering_position(segment.upper, segment.upper_offset)
+                                         : get_ordering_position(segment.lower, segment.lower_offset);
+            }
+            const size_t count = neighbours.first[vertex + 1] - neighbours.first[vertex];
+            // Vertices without neighbours keep their place.
+            barycenters[vertex] = count == 0 ? static_cast<double>(m_positions[vertex]) + 0.5
+                                             : sum / static_cast<double>(count);
+        }
+        std::stable_sort(layer.begin(), layer.end(), [&barycenters](const size_t lhs, const size_t rhs) {
+            return barycenters[lhs] < barycenters[rhs];
+        });
+        for (size_t position = 0; position < layer.size(); ++position)
+        {
+            m_positions[layer[position]] = position;
         }
-
-        auto type_name = impl::get_type_name_string<simple_type_t, string_t>();
-        auto instance_address = impl::get_address_as_string<string_t>(&data_structure);
-        auto node_for_instance = table_node<string_t>{}
-                                     .with_row(std::move(type_name), std::move(instance_address))
-                                     .with_row(table_node<string_t>::cell::make(data_structure).spanning_columns(2));
-        add_node(node_id, std::move(node_for_instance));
-        return node_id;
     }
 
-    // For raw pointers.
-    template <typename pointer_type_t>
-    uint64_t add_data_structure(
-        const pointer_type_t &data_structure,
-        std::enable_if_t<std::is_pointer_v<pointer_type_t> && !std::is_null_pointer_v<pointer_type_t>, bool> = true)
+    // Counts the crossings between a rank and the next one: the inversions of the lower ends of the segments, sorted by
+    // their upper end, counted with a Fenwick tree.
+    [[nodiscard]] size_t count_crossings(const size_t rank, std::vector<std::pair<size_t, size_t>> &ends,
+                                         std::vector<size_t> &tree) const
     {
-        // Special case for the null pointer.
-        if (data_structure == nullptr)
+        ends.clear();
+        for (const size_t vertex : m_layers[rank])
         {
-            if (has_node(impl::nullptr_pointer_node_id))
+            for (size_t item = m_lower_segments.first[vertex]; item < m_lower_segments.first[vertex + 1]; ++item)
             {
-                return impl::nullptr_pointer_node_id;
+                ends.emplace_back(m_positions[vertex], m_positions[m_segments[m_lower_segments.items[item]].lower]);
             }
+        }
+        std::sort(ends.begin(), ends.end());
 
-            auto node_for_pointer = table_node<string_t>{}.with_row(lit(string_t, "nullptr"));
-            add_node(impl::nullptr_pointer_node_id, std::move(node_for_pointer));
-            return impl::nullptr_pointer_node_id;
+        const size_t lower_count = m_layers[rank + 1].size();
+        tree.assign(lower_count + 1, 0);
+        size_t crossing_count = 0;
+        for (size_t inserted_count = 0; inserted_count < ends.size(); ++inserted_count)
+        {
+            // Number of segments already inserted ending at or before this one.
+            size_t not_crossing_count = 0;
+            for (size_t index = ends[inserted_count].second + 1; index > 0; index -= index & (~index + 1))
+            {
+                not_crossing_count += tree[index];
+            }
+            crossing_count += inserted_count - not_crossing_count;
+            for (size_t index = ends[inserted_count].second + 1; index <= lower_count; index += index & (~index + 1))
+            {
+                ++tree[index];
+            }
         }
+        return crossing_count;
+    }
 
-        // General case.
-        else
+    [[nodiscard]] size_t count_crossings() const
+    {
+        std::vector<std::pair<size_t, size_t>> ends;
+        std::vector<size_t> tree;
+        size_t crossing_count = 0;
+        for (size_t rank = 0; rank + 1 < m_layers.size(); ++rank)
         {
-            // First add a node for the pointed value (recursion).
-            const uint64_t pointed_value_node_id = add_data_structure(*data_structure);
+            crossing_count += count_crossings(rank, ends, tree);
+        }
+        return crossing_count;
+    }
 
-            // Then add a simple table node for the pointer:
-            // |---------------------------|
-            // |  <Type name> |  <Address> |
-            // |---------------------------|
-            // | <Value = Pointed address> |  <--- port = "ptr"
-            // |---------------------------|
-            string_t ptr_port_name{lit(string_t, "ptr")};
-            const uint64_t pointer_node_id = impl::get_node_id_for_value(data_structure);
-            if (has_node(pointer_node_id))
+    void order_ranks(const svg_export_options &options)
+    {
+        make_initial_order();
+        m_crossing_count = count_crossings();
+
+        const auto deadline = std::chrono::steady_clock::now() + options.crossing_reduction_budget;
+        std::vector<std::vector<size_t>> best_layers = m_layers;
+        std::vector<double> barycenters(m_widths.size(), 0.0);
+        constexpr size_t max_sweeps_without_improvement = 4;
+        size_t sweeps_without_improvement = 0;
+        bool is_out_of_time = false;
+        for (size_t sweep = 0; sweep < options.max_crossing_reduction_sweeps && m_crossing_count > 0 &&
+                               sweeps_without_improvement < max_sweeps_without_improvement && !is_out_of_time;
+             ++sweep)
+        {
+            const bool is_downward_sweep = sweep % 2 == 0;
+            for (size_t step = 1; step < m_layers.size() && !is_out_of_time; ++step)
             {
-                return pointer_node_id;
+                reorder_rank(is_downward_sweep ? step : m_layers.size() - 1 - step, is_downward_sweep, barycenters);
+                is_out_of_time = std::chrono::steady_clock::now() >= deadline;
             }
 
-            auto pointer_type_name = impl::get_type_name_string<pointer_type_t, string_t>();
-            auto address_of_pointer = impl::get_address_as_string<string_t>(&data_structure);
-            auto node_for_pointer =
-                table_node<string_t>{}
-                    .with_row(std::move(pointer_type_name), std::move(address_of_pointer))
-                    .with_row(
-                        table_node<string_t>::cell::make(data_structure).spanning_columns(2).with_port(ptr_port_name));
-            add_node(pointer_node_id, std::move(node_for_pointer));
-
-            // Finally, add an edge between the two.
-            add_unique_edge(
-                arrow<string_t>{pointer_node_id, std::move(ptr_port_name), pointed_value_node_id, lit(string_t, "")});
+            // An interrupted sweep can still be better than the best order.
+            const size_t crossing_count = count_crossings();
+            if (crossing_count < m_crossing_count)
+            {
+                m_crossing_count = crossing_count;
+                best_layers = m_layers;
+                sweeps_without_improvement = 0;
+            }
+            else
+            {
+                ++sweeps_without_improvement;
+            }
+        }
 
-            return pointer_node_id;
+        m_layers = std::move(best_layers);
+        for (const std::vector<size_t> &layer : m_layers)
+        {
+            for (size_t position = 0; position < layer.size(); ++position)
+            {
+                m_positions[layer[position]] = position;
+            }
         }
     }
 
-    // For the null pointer type, to resolve ambiguous function calls when passing a nullptr_t to add_data_structure.
-    template <typename nullptr_type>
-    uint64_t add_data_structure(const nullptr_type &,
-                                std::enable_if_t<std::is_null_pointer_v<nullptr_type>, bool> = true)
+    // Places the vertices of a rank as close as possible to their desired x (least squares), in their order and without
+    // overlapping. With o the packed position of each vertex, this is the isotonic regression of desired - o, solved by
+    // pooling adjacent violators.
+    void place_rank(const std::vector<size_t> &layer, const std::vector<double> &desired_x, const double separation)
     {
-        if (has_node(impl::nullptr_pointer_node_id))
+        std::vector<double> packed_x(layer.size(), 0.0);
+        for (size_t position = 1; position < layer.size(); ++position)
         {
-            return impl::nullptr_pointer_node_id;
+            packed_x[position] =
+                packed_x[position - 1] + (m_widths[layer[position - 1]] + m_widths[layer[position]]) / 2 + separation;
         }
 
-        auto node_for_pointer = table_node<string_t>{}.with_row(lit(string_t, "nullptr"));
-        add_node(impl::nullptr_pointer_node_id, std::move(node_for_pointer));
-        return impl::nullptr_pointer_node_id;
+        // Blocks of consecutive vertices sharing the same shift: sum of the shifts they want, vertex count.
+        std::vector<std::pair<double, size_t>> blocks;
+        for (size_t position = 0; position < layer.size(); ++position)
+        {
+            blocks.emplace_back(desired_x[layer[position]] - packed_x[position], 1);
+            while (blocks.size() > 1 &&
+                   blocks[blocks.size() - 2].first * static_cast<double>(blocks.back().second) >
+                       blocks.back().first * static_cast<double>(blocks[blocks.size() - 2].second))
+            {
+                blocks[blocks.size() - 2].first += blocks.back().first;
+                blocks[blocks.size() - 2].second += blocks.back().second;
+                blocks.pop_back();
+            }
+        }
+        size_t position = 0;
+        for (const auto &[shift_sum, count] : blocks)
+        {
+            const double shift = shift_sum / static_cast<double>(count);
+            for (size_t index = 0; index < count; ++index, ++position)
+            {
+                m_x[layer[position]] = packed_x[position] + shift;
+            }
+        }
     }
 
-    // Special case for C-style strings.
-    template <typename cstring_type>
-    uint64_t add_data_structure(const cstring_type &data_structure,
-                                std::enable_if_t<impl::is_cstring_type_v<cstring_type>, bool> = true)
+    void assign_coordinates(const svg_export_options &options)
     {
-        // Add a simple table node:
-
-        // |-------------------------|
-        // | <Type name> | <Address> |
-        // |-------------------------|
-        // |          <Value>        |
-        // |-------------------------|
+        const size_t vertex_count = m_widths.size();
+        m_x.assign(vertex_count, 0.0);
+        m_y.assign(vertex_count, 0.0);
+        std::vector<double> desired_x(vertex_count, 0.0);
+        for (const std::vector<size_t> &layer : m_layers)
+        {
+            place_rank(layer, desired_x, options.node_separation);
+        }
 
-        const uint64_t node_id = impl::get_node_id_for_value(data_structure);
-        if (has_node(node_id))
+        // Alternate sweeps pulling each vertex towards its neighbours in the previous rank of the sweep.
+        constexpr size_t sweep_count = 8;
+        for (size_t sweep = 0; sweep < sweep_count; ++sweep)
         {
-            return node_id;
+            const bool is_downward_sweep = sweep % 2 == 0;
+            const adjacency &neighbours = is_downward_sweep ? m_upper_segments : m_lower_segments;
+            for (size_t step = 1; step < m_layers.size(); ++step)
+            {
+                const std::vector<size_t> &layer = m_layers[is_downward_sweep ? step : m_layers.size() - 1 - step];
+                for (const size_t vertex : layer)
+                {
+                    const size_t count = neighbours.first[vertex + 1] - neighbours.first[vertex];
+                    double sum = 0.0;
+                    for (size_t item = neighbours.first[vertex]; item < neighbours.first[vertex + 1]; ++item)
+                    {
+                        const segment &segment = m_segments[neighbours.items[item]];
+                        sum += is_downward_sweep ? m_x[segment.upper] + segment.upper_offset - segment.lower_offset
+                                                 : m_x[segment.lower] + segment.lower_offset - segment.upper_offset;
+                    }
+                    desired_x[vertex] = count == 0 ? m_x[vertex] : sum / static_cast<double>(count);
+                }
+                place_rank(layer, desired_x, options.node_separation);
+            }
         }
 
-        auto type_name = impl::get_type_name_string<cstring_type, string_t>();
-        auto instance_address = impl::get_address_as_string<string_t>(&data_structure);
-        auto node_for_instance = table_node<string_t>{}
-                                     .with_row(std::move(type_name), std::move(instance_address))
-                                     .with_row(table_node<string_t>::cell::make(data_structure).spanning_columns(2));
-        add_node(node_id, std::move(node_for_instance));
-        return node_id;
-    }
+        // Shift everything into the drawing, and stack the ranks with their top aligned.
+        const double margin = options.node_separation;
+        double min_x = std::numeric_limits<double>::max();
+        double max_x = std::numeric_limits<double>::lowest();
+        for (size_t vertex = 0; vertex < vertex_count; ++vertex)
+        {
+            min_x = std::min(min_x, m_x[vertex] - m_widths[vertex] / 2);
+            max_x = std::max(max_x, m_x[vertex] + m_widths[vertex] / 2);
+        }
+        for (double &x : m_x)
+        {
+            x += margin - min_x;
+        }
+        m_width = vertex_count == 0 ? 0.0 : max_x - min_x + 2 * margin;
 
-  private:
-    /**
-     * Key   = node ID.
-     * Value = node instance.
-     */
-    std::unordered_map<uint64_t, std::unique_ptr<base_node<string_t>>> m_nodes;
-    /**
-     * Key   = hash of the pair source_node_id -> destination_node_id in the connection.
-     * Value = description of the edge.
-     */
-    std::vector<arrow<string_t>> m_directed_edges;
-    /**
-     *
-     */
-    std::vector<cluster<string_t>> m_clusters; // TODO: not handled yet.
+        double rank_top = margin;
+        m_rank_tops.clear();
+        m_rank_heights.clear();
+        for (const std::vector<size_t> &layer : m_layers)
+        {
+            double rank_height = 0.0;
+            for (const size_t vertex : layer)
+            {
+                rank_height = std::max(rank_height, m_heights[vertex]);
+            }
+            for (const size_t vertex : layer)
+            {
+                m_y[vertex] = vertex < m_vertex_count ? rank_top + m_heights[vertex] / 2 : rank_top + rank_height / 2;
+            }
+            m_rank_tops.push_back(rank_top);
+            m_rank_heights.push_back(rank_height);
+            rank_top += rank_height + options.rank_separation;
+        }
+        m_height = m_layers.empty() ? 0.0 : rank_top - options.rank_separation + margin;
+    }
 
-    std::vector<rank_constraint> m_rank_constraints;
+    void route_edges()
+    {
+        m_routes.resize(m_edges.size());
+        for (size_t edge_index = 0; edge_index < m_edges.size(); ++edge_index)
+        {
+            std::vector<point> &route = m_routes[edge_index];
+            const size_t first = m_chain_first[edge_index];
+            const size_t last = m_chain_first[edge_index + 1] - 1;
+            const size_t upper = m_chains[first];
+            const size_t lower = m_chains[last];
+            const edge &edge = m_edges[edge_index];
+            const double upper_offset = m_is_reversed[edge_index] ? edge.destination_offset : edge.source_offset;
+            const double lower_offset = m_is_reversed[edge_index] ? edge.source_offset : edge.destination_offset;
+            route.reserve(2 * (last - first));
+
+            // From the bottom of the upper vertex, vertically through the ranks crossed, to the top of the lower
+            // vertex.
+            route.push_back({m_x[upper] + upper_offset, m_y[upper] + m_heights[upper] / 2});
+            for (size_t position = first + 1; position < last; ++position)
+            {
+                const size_t dummy = m_chains[position];
+                route.push_back({m_x[dummy], m_rank_tops[m_ranks[dummy]]});
+                route.push_back({m_x[dummy], m_rank_tops[m_ranks[dummy]] + m_rank_heights[m_ranks[dummy]]});
+            }
+            route.push_back({m_x[lower] + lower_offset, m_y[lower] - m_heights[lower] / 2});
 
-    friend string_t generate_dot_visualization_string<string_t>(const visualization<string_t> &);
-};
+            if (m_is_reversed[edge_index])
+            {
+                std::reverse(route.begin(), route.end());
+            }
+        }
+    }
 
-// ------------------------------------------- graphviz generation ------------------------------------------ //
+    size_t m_vertex_count;
+    // Per vertex, dummy vertices included.
+    std::vector<double> m_widths;
+    std::vector<double> m_heights;
+    std::vector<size_t> m_ranks;
+    std::vector<size_t> m_positions;
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+
+    std::vector<edge> m_edges;
+    std::vector<bool> m_is_reversed;
+    // Vertices of each edge from its upper end to its lower end: m_chains[m_chain_first[e]] to m_chains[m_chain_first[e
+    // + 1] - 1].
+    std::vector<size_t> m_chain_first;
+    std::vector<size_t> m_chains;
+    std::vector<segment> m_segments;
+    adjacency m_upper_segments;
+    adjacency m_lower_segments;
+
+    std::vector<std::vector<size_t>> m_layers;
+    std::vector<double> m_rank_tops;
+    std::vector<double> m_rank_heights;
+    std::vector<std::vector<point>> m_routes;
+    size_t m_crossing_count{0};
+    double m_width{0.0};
+    double m_height{0.0};
+};
 
-namespace impl
-{
+/**
+ * Table of a node drawn in SVG: its cells, and the columns they are laid out in.
+ */
 template <typename string_t>
-[[nodiscard]] string_t generate_cluster_style_string(const cluster<string_t> cluster)
+struct svg_table
 {
-    string_t result;
-    if (cluster.style != cluster_style::normal)
+    std::vector<std::vector<grid_cell<string_t>>> rows;
+    std::vector<double> column_lefts; // One more than the number of columns: the right of the last column.
+    std::unordered_map<string_t, double> port_offsets; // Center of the cell of each port, from the center of the table.
+
+    [[nodiscard]] double get_width() const
     {
-        constexpr size_t max_result_length = 15; // "style=striped;\0"  => 15 chars
-        result.reserve(max_result_length);
-        result += lit(string_t, "style=");
-        result += get_cluster_style_name<string_t>(cluster.style);
-        result += lit(string_t, ";\n");
+        return column_lefts.back();
     }
-    return result;
-}
+};
 
+/**
+ * \return The number of characters displayed for the content of a cell of an HTML label: tags are not displayed, and
+ * entities are a single character.
+ */
 template <typename string_t>
-[[nodiscard]] string_t generate_cluster_color_string(const cluster<string_t> cluster)
+size_t get_displayed_length(const string_t &html)
 {
-    string_t result;
-    if (!cluster.cluster_color.empty())
+    size_t length = 0;
+    for (size_t index = 0; index < html.size(); ++index)
     {
-        const size_t result_length = 8 + cluster.cluster_color.size(); // "color=<color>;\0"  => 8 + len(<color>) chars
-        result.reserve(result_length);
-        result += lit(string_t, "color=");
-        result += cluster.cluster_color;
-        result += lit(string_t, ";\n");
+        if (html[index] == '<')
+        {
+            index = std::min(html.find('>', index), html.size());
+        }
+        else
+        {
+            if (html[index] == '&')
+            {
+                index = std::min(html.find(';', index), html.size());
+            }
+            ++length;
+        }
     }
-    return result;
+    return length;
 }
 
+/**
+ * Appends the content of a cell of an HTML label as SVG text: tags are dropped, entities kept, except "&nbsp;" which
+ * SVG does not define.
+ */
 template <typename string_t>
-[[nodiscard]] string_t generate_cluster_label_string(const cluster<string_t> cluster)
+void append_svg_text(string_t &result, const string_t &html)
 {
-    string_t result;
-    if (!cluster.cluster_label.empty())
+    const string_t non_breaking_space{lit(string_t, "&nbsp;")};
+    for (size_t index = 0; index < html.size(); ++index)
     {
-        const size_t result_length = 8 + cluster.cluster_label.size(); // "label=<label>;\0"  => 8 + len(<label>) chars
-        result.reserve(result_length);
-        result += lit(string_t, "label=");
-        result += cluster.cluster_label;
-        result += lit(string_t, ";\n");
+        if (html[index] == '<')
+        {
+            index = std::min(html.find('>', index), html.size());
+        }
+        else if (html.compare(index, non_breaking_space.size(), non_breaking_space) == 0)
+        {
+            result += lit(string_t, "&#160;");
+            index += non_breaking_space.size() - 1;
+        }
+        else
+        {
+            result += html[index];
+        }
     }
-    return result;
 }
 
 template <typename string_t>
-[[nodiscard]] string_t generate_default_node_appearance_string(const cluster<string_t> cluster)
+void append_svg_number(string_t &result, const double value)
 {
-    string_t result;
-    result += lit(string_t, "node[");
-    result += generate_node_appearance_string(
-        cluster.default_node_appearance,
-        node_appearance{}); // Default-constructed values won't generate any appearance information.
-    result += lit(string_t, "]\n");
-    return result;
+    result += cdv::to_string<string_t>(static_cast<long long>(std::lround(value)));
 }
 
 template <typename string_t>
-[[nodiscard]] string_t generate_node_appearance_string(const node_appearance<string_t> &appearance,
-                                                       const node_appearance<string_t> &default_node_appearance)
+svg_table<string_t> make_svg_table(std::vector<std::vector<grid_cell<string_t>>> &&rows,
+                                   const svg_export_options &options)
 {
-    // Override default appearance for the different visual parameters.
-    // Don't write anything if the settings are the same as the current default,
-    // to reduce output size as much as possible.
-
-    string_t result; // TODO: optim: reserve
+    svg_table<string_t> table;
+    table.rows = std::move(rows);
+    const double character_width = 0.6 * options.font_size; // Usual advance of monospace fonts.
+    const auto get_cell_width = [&](const grid_cell<string_t> &cell) {
+        return static_cast<double>(get_displayed_length(cell.html)) * character_width + 2 * options.cell_padding;
+    };
 
-    if (appearance.shape != default_node_appearance.shape)
+    // Like in the DOT export, rows with fewer cells than the longest one are completed by empty cells.
+    size_t column_count = 1;
+    for (const auto &row : table.rows)
     {
-        result += lit(string_t, "shape=");
-        result += get_node_shape_name<string_t>(appearance.shape);
-        result += lit(string_t, ",");
+        size_t row_column_count = 0;
+        for (const auto &cell : row)
+        {
+            row_column_count += static_cast<size_t>(std::max(cell.column_span, 1));
+        }
+        column_count = std::max(column_count, row_column_count);
     }
 
-    if (appearance.style != default_node_appearance.style)
+    // Columns as wide as their widest cell. Cells spanning several columns widen the last one if needed.
+    std::vector<double> column_widths(column_count, 2 * options.cell_padding);
+    for (const bool is_spanning : {false, true})
     {
-        result += lit(string_t, "style=");
-        result += get_node_style_name<string_t>(appearance.style);
-        result += lit(string_t, ",");
+        for (const auto &row : table.rows)
+        {
+            size_t column = 0;
+            for (const auto &cell : row)
+            {
+                const auto span = static_cast<size_t>(std::max(cell.column_span, 1));
+                if ((span > 1) == is_spanning)
+                {
+                    const double spanned_width =
+                        std::accumulate(column_widths.begin() + column, column_widths.begin() + column + span, 0.0);
+                    column_widths[column + span - 1] += std::max(0.0, get_cell_width(cell) - spanned_width);
+                }
+                column += span;
+            }
+        }
     }
+    table.column_lefts.resize(column_count + 1, 0.0);
+    std::partial_sum(column_widths.begin(), column_widths.end(), table.column_lefts.begin() + 1);
 
-    if (appearance.color != default_node_appearance.color)
+    const double center = table.get_width() / 2;
+    for (const auto &row : table.rows)
     {
-        result += lit(string_t, "color=");
-        result += appearance.color;
-        result += lit(string_t, ",");
+        size_t column = 0;
+        for (const auto &cell : row)
+        {
+            const auto span = static_cast<size_t>(std::max(cell.column_span, 1));
+            if (!cell.port_name.empty())
+            {
+                const double cell_center = (table.column_lefts[column] + table.column_lefts[column + span]) / 2;
+                table.port_offsets.emplace(cell.port_name, cell_center - center);
+            }
+            column += span;
+        }
     }
-
-    return result;
+    return table;
 }
 
 template <typename string_t>
-[[nodiscard]] string_t generate_table_node_cell_html(const typename table_node<string_t>::cell &cell)
+void append_svg_table(string_t &result, const svg_table<string_t> &table, const double left, const double top,
+                      const double row_height, const svg_export_options &options)
 {
-    string_t result; // TODO: optim: reserve
-
-    // 1. Open the cell and fill its parameters.
-    result += lit(string_t, "<td ");
-
-    // Generate ' rowspan="<value>"' if non-default span.
-    if (cell.row_span != cell.default_row_span)
+    const size_t column_count = table.column_lefts.size() - 1;
+    for (size_t row_index = 0; row_index < table.rows.size(); ++row_index)
     {
-        result += lit(string_t, " rowspan=\"");
-        result += cdv::to_string<string_t>(cell.row_span);
-        result += lit(string_t, "\"");
+        // Borders rounded to whole pixels, shared by neighbouring cells.
+        const double row_top = std::round(top + static_cast<double>(row_index) * row_height);
+        const double row_bottom = std::round(top + static_cast<double>(row_index + 1) * row_height);
+        size_t column = 0;
+        const auto append_cell = [&](const grid_cell<string_t> &cell, const size_t span) {
+            const double cell_left = std::round(left + table.column_lefts[column]);
+            const double cell_right = std::round(left + table.column_lefts[column + span]);
+            result += lit(string_t, "<rect x=\"");
+            append_svg_number(result, cell_left);
+            result += lit(string_t, "\" y=\"");
+            append_svg_number(result, row_top);
+            result += lit(string_t, "\" width=\"");
+            append_svg_number(result, cell_right - cell_left);
+            result += lit(string_t, "\" height=\"");
+            append_svg_number(result, row_bottom - row_top);
+            if (!cell.background_color.empty())
+            {
+                result += lit(string_t, "\" style=\"fill:");
+                result += cell.background_color;
+            }
+            result += lit(string_t, "\"/>");
+            if (!cell.html.empty())
+            {
+                const bool is_bold = cell.html.compare(0, 3, lit(string_t, "<b>")) == 0;
+                result += is_bold ? lit(string_t, "<text font-weight=\"bold\" x=\"") : lit(string_t, "<text x=\"");
+                append_svg_number(result, cell_left + options.cell_padding);
+                result += lit(string_t, "\" y=\"");
+                append_svg_number(result, row_top + options.cell_padding + 0.8 * options.font_size);
+                result += lit(string_t, "\">");
+                append_svg_text(result, cell.html);
+                result += lit(string_t, "</text>");
+            }
+            result += new_line<string_t>();
+            column += span;
+        };
+        for (const auto &cell : table.rows[row_index])
+        {
+            append_cell(cell, static_cast<size_t>(std::max(cell.column_span, 1)));
+        }
+        const grid_cell<string_t> empty_cell{};
+        while (column < column_count)
+        {
+            append_cell(empty_cell, 1);
+        }
     }
-    // Generate ' colspan="<value>"' if non-default span.
-    if (cell.column_span != cell.default_column_span)
+}
+} // namespace impl
+
+/**
+ * Lays the graph out and draws it as SVG, without Graphviz. The layout is layered (Sugiyama-style): the edges go down
+ * from rank to rank, except the ones closing cycles, and the order of the nodes in each rank is chosen to limit the
+ * number of crossings within a time budget. Tables are sized from the number of characters of their cells.
+ * \note The summarization and grouping options of the DOT export are not available, and nothing is drawn in streaming
+ * mode.
+ */
+template <typename string_t>
+[[nodiscard]] string_t generate_svg_visualization_string(const visualization<string_t> &visualization,
+                                                         const svg_export_options &options)
+{
+    const double row_height = options.font_size + 2 * options.cell_padding;
+
+    // 1. Tables of the nodes, in the order they were added.
+    const std::vector<uint64_t> &node_ids = visualization.m_node_order;
+    std::unordered_map<uint64_t, size_t> vertices_by_node_id;
+    vertices_by_node_id.reserve(node_ids.size());
+    std::vector<impl::svg_table<string_t>> tables;
+    tables.reserve(node_ids.size());
+    std::vector<double> widths;
+    std::vector<double> heights;
+    widths.reserve(node_ids.size());
+    heights.reserve(node_ids.size());
+    for (const uint64_t node_id : node_ids)
     {
-        result += lit(string_t, " colspan=\"");
-        result += cdv::to_string<string_t>(cell.column_span);
-        result += lit(string_t, "\"");
+        vertices_by_node_id.emplace(node_id, tables.size());
+        tables.push_back(impl::make_svg_table(visualization.m_nodes.find(node_id)->second->get_grid_rows(), options));
+        widths.push_back(tables.back().get_width());
+        heights.push_back(static_cast<double>(std::max<size_t>(tables.back().rows.size(), 1)) * row_height);
     }
-    // Generate ' port="<value>"' if a port is specified for this cell.
-    if (!cell.port_name.empty())
+
+    // 2. Edges from port to port. Self loops are drawn beside their node, out of the layout.
+    const auto get_port_offset = [&tables](const size_t vertex, const string_t &port_name) {
+        const auto port_offset = tables[vertex].port_offsets.find(port_name);
+        return port_offset != tables[vertex].port_offsets.end() ? port_offset->second : 0.0;
+    };
+    std::vector<impl::layered_layout::edge> edges;
+    std::vector<const arrow<string_t> *> edge_arrows;
+    std::vector<std::pair<size_t, const arrow<string_t> *>> self_loops;
+    for (const arrow<string_t> &arrow : visualization.m_directed_edges)
     {
-        result += lit(string_t, " port=\"");
-        result += cell.port_name;
-        result += lit(string_t, "\"");
+        const auto source = vertices_by_node_id.find(arrow.source_node_id);
+        const auto destination = vertices_by_node_id.find(arrow.destination_node_id);
+        if (source == vertices_by_node_id.end() || destination == vertices_by_node_id.end() ||
+            arrow.style == edge_style::invis)
+        {
+            continue;
+        }
+        if (source->second == destination->second)
+        {
+            self_loops.emplace_back(source->second, &arrow);
+            continue;
+        }
+        edges.push_back({source->second, destination->second, get_port_offset(source->second, arrow.source_port),
+                         get_port_offset(destination->second, arrow.destination_port)});
+        edge_arrows.push_back(&arrow);
     }
 
-    result += lit(string_t, ">");
+    // 3. Layout.
+    impl::layered_layout layout{std::move(widths), std::move(heights), std::move(edges)};
+    layout.run(options);
 
-    // 2. The value in the cell.
-    result += cell.value;
+    // 4. Drawing: the edges first, under the nodes.
+    string_t result;
+    result.reserve(node_ids.size() * 400 + edge_arrows.size() * 100);
+    const double loop_size = options.node_separation;
+    result += lit(string_t, "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"");
+    impl::append_svg_number(result, layout.get_width() + loop_size);
+    result += lit(string_t, "\" height=\"");
+    impl::append_svg_number(result, layout.get_height());
+    result += lit(string_t, "\" font-family=\"monospace\" font-size=\"");
+    impl::append_svg_number(result, options.font_size);
+    result += lit(string_t, "\">\n<defs><marker id=\"arrowhead\" viewBox=\"0 0 10 10\" refX=\"10\" refY=\"5\" "
+                            "markerWidth=\"8\" markerHeight=\"8\" orient=\"auto\">"
+                            "<path d=\"M0,0L10,5L0,10z\"/></marker>"
+                            "<style>rect{fill:white;stroke:black}</style></defs>\n"
+                            "<g fill=\"none\" stroke=\"black\" marker-end=\"url(#arrowhead)\">\n");
+    const auto append_edge_style = [&result](const edge_style style) {
+        if (style == edge_style::dashed)
+        {
+            result += lit(string_t, "\" stroke-dasharray=\"6,3");
+        }
+        else if (style == edge_style::dotted)
+        {
+            result += lit(string_t, "\" stroke-dasharray=\"1,3");
+        }
+        else if (style == edge_style::bold)
+        {
+            result += lit(string_t, "\" stroke-width=\"2");
+        }
+    };
+    for (size_t edge_index = 0; edge_index < edge_arrows.size(); ++edge_index)
+    {
+        result += lit(string_t, "<path d=\"");
+        const auto &route = layout.get_route(edge_index);
+        for (size_t point_index = 0; point_index < route.size(); ++point_index)
+        {
+            result += point_index == 0 ? lit(string_t, "M") : lit(string_t, "L");
+            impl::append_svg_number(result, route[point_index].x);
+            result += lit(string_t, ",");
+            impl::append_svg_number(result, route[point_index].y);
+        }
+        append_edge_style(edge_arrows[edge_index]->style);
+        result += lit(string_t, "\"/>\n");
+    }
+    for (const auto &[vertex, arrow] : self_loops)
+    {
+        const auto center = layout.get_center(vertex);
+        const double right = center.x + tables[vertex].get_width() / 2;
+        result += lit(string_t, "<path d=\"M");
+        impl::append_svg_number(result, right);
+        result += lit(string_t, ",");
+        impl::append_svg_number(result, center.y - row_height / 2);
+        result += lit(string_t, "C");
+        impl::append_svg_number(result, right + loop_size);
+        result += lit(string_t, ",");
+        impl::append_svg_number(result, center.y - row_height);
+        result += lit(string_t, " ");
+        impl::append_svg_number(result, right + loop_size);
+        result += lit(string_t, ",");
+        impl::append_svg_number(result, center.y + row_height);
+        result += lit(string_t, " ");
+        impl::append_svg_number(result, right);
+        result += lit(string_t, ",");
+        impl::append_svg_number(result, center.y + row_height / 2);
+        append_edge_style(arrow->style);
+        result += lit(string_t, "\"/>\n");
+    }
+    result += lit(string_t, "</g>\n<g>\n");
 
-    // 3. Close the cell.
-    result += lit(string_t, "</td>");
+    for (size_t vertex = 0; vertex < tables.size(); ++vertex)
+    {
+        const auto center = layout.get_center(vertex);
+        const double height = static_cast<double>(std::max<size_t>(tables[vertex].rows.size(), 1)) * row_height;
+        if (tables[vertex].rows.empty())
+        {
+            // Nodes that are not tables.
+            result += lit(string_t, "<rect x=\"");
+            impl::append_svg_number(result, center.x - tables[vertex].get_width() / 2);
+            result += lit(string_t, "\" y=\"");
+            impl::append_svg_number(result, center.y - height / 2);
+            result += lit(string_t, "\" width=\"");
+            impl::append_svg_number(result, tables[vertex].get_width());
+            result += lit(string_t, "\" height=\"");
+            impl::append_svg_number(result, height);
+            result += lit(string_t, "\"/>\n");
+        }
+        impl::append_svg_table(result, tables[vertex], center.x - tables[vertex].get_width() / 2,
+                               center.y - height / 2, row_height, options);
+    }
+    result += lit(string_t, "</g>\n</svg>\n");
     return result;
 }
-} // namespace impl
 
-template <typename string_t>
-[[nodiscard]] string_t generate_dot_visualization_string(const visualization<string_t> &visualization)
+/**
+ * \return A text table of memory usages per type, one line per type, followed by the totals.
+ */
+inline std::string generate_memory_report_string(const std::vector<type_memory_usage> &usages)
 {
-    string_t result;
-    constexpr size_t estimated_characters_per_node = 1000; // TODO: find an actual estimation, this number is BS.
-    result.reserve(visualization.m_nodes.size() * estimated_characters_per_node);
-
-    // 1. Graph setup, with all the cluster information of the global graph
-    // (the global graph itself is a cluster).
-    result += lit(string_t, "digraph G {\n");
-    result += impl::generate_cluster_color_string(visualization);
-    result += impl::generate_cluster_label_string(visualization);
-    result += impl::generate_cluster_style_string(visualization);
-    result += impl::generate_default_node_appearance_string(visualization);
+    std::ostringstream report;
+    report << std::setw(5) << "num" << std::setw(12) << "#instances" << std::setw(14) << "#bytes" << std::setw(14)
+           << "object" << std::setw(14) << "embedded" << std::setw(14) << "heap" << "  type\n";
 
-    // 2. Print each node's structure, ie actual node content.
-    for (const auto &[node_id, node] : visualization.m_nodes)
+    size_t rank = 0;
+    type_memory_usage total;
+    for (const type_memory_usage &usage : usages)
     {
-        // Each graphviz node is uniquely identified by this ID. Used later for edges.
-        result += cdv::to_string<string_t>(node_id);
-        // Actual content of the nodes.
-        result += node->generate_structure_string(visualization.default_node_appearance);
-        // One node per line.
-        result += new_line<string_t>();
+        report << std::setw(4) << ++rank << ':' << std::setw(12) << usage.instance_count << std::setw(14)
+               << usage.get_total_bytes() << std::setw(14) << usage.object_bytes << std::setw(14)
+               << usage.embedded_bytes << std::setw(14) << usage.heap_bytes << "  " << usage.type_name << '\n';
+        total.instance_count += usage.instance_count;
+        total.object_bytes += usage.object_bytes;
+        total.embedded_bytes += usage.embedded_bytes;
+        total.heap_bytes += usage.heap_bytes;
     }
 
-    // 3. Print each arrow / directed edge between nodes.
-    for (const auto &arrow : visualization.m_directed_edges)
+    report << std::setw(5) << "Total" << std::setw(12) << total.instance_count << std::setw(14)
+           << total.get_total_bytes() << std::setw(14) << total.object_bytes << std::setw(14) << total.embedded_bytes
+           << std::setw(14) << total.heap_bytes << '\n';
+    return report.str();
+}
+
+inline std::string generate_locality_report_string(const std::vector<locality_metrics> &metrics)
+{
+    const auto percentage = [](const size_t count, const size_t total) {
+        return total == 0 ? 0.0 : 100.0 * static_cast<double>(count) / static_cast<double>(total);
+    };
+
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(1);
+    report << std::setw(12) << "hops" << std::setw(11) << "same line" << std::setw(11) << "same page" << std::setw(9)
+           << "forward" << std::setw(10) << "< 64 B" << std::setw(10) << "< 4 KB" << std::setw(10) << "< 2 MB"
+           << std::setw(10) << "< 1 GB" << std::setw(10) << ">= 1 GB" << std::setw(7) << "score" << "  type\n";
+    for (const locality_metrics &type_metrics : metrics)
     {
-        // Source node with port if specified.
-        result += cdv::to_string<string_t>(arrow.source_node_id);
-        if (!arrow.source_port.empty())
+        const size_t hop_count = type_metrics.hop_count;
+        report << std::setw(12) << hop_count << std::setw(10)
+               << percentage(type_metrics.same_cache_line_hop_count, hop_count) << '%' << std::setw(10)
+               << percentage(type_metrics.same_page_hop_count, hop_count) << '%' << std::setw(8)
+               << percentage(type_metrics.forward_hop_count, hop_count) << '%';
+        for (const size_t bin_hop_count : type_metrics.stride_histogram)
         {
-            result += lit(string_t, ":");
-            result += cdv::to_string<string_t>(arrow.source_port);
+            report << std::setw(10) << bin_hop_count;
         }
+        report << std::setprecision(2) << std::setw(7) << type_metrics.get_locality_score() << std::setprecision(1)
+               << "  " << type_metrics.type_name << '\n';
+    }
+    return report.str();
+}
 
-        // The arrow.
-        result += lit(string_t, " -> ");
+inline std::string generate_class_layout_report_string(const std::vector<class_layout_usage> &usages)
+{
+    constexpr size_t line_bytes = class_layout::cache_line_bytes;
 
-        // Destination node with port if specified.
-        result += cdv::to_string<string_t>(arrow.destination_node_id);
-        if (!arrow.destination_port.empty())
+    std::ostringstream report;
+    for (const class_layout_usage &usage : usages)
+    {
+        const class_layout &layout = *usage.layout;
+        report << layout.type_name << ": " << layout.size << " bytes, aligned on " << layout.alignment << ", "
+               << usage.instance_count << " instances\n";
+        report << std::setw(8) << "offset" << std::setw(8) << "size" << std::setw(8) << "line" << "  member\n";
+
+        // Members and holes, by increasing offset. The cache lines are relative to the beginning of the object.
+        const std::vector<layout_hole> holes = layout.get_holes();
+        auto hole = holes.begin();
+        auto member = layout.members.begin();
+        while (hole != holes.end() || member != layout.members.end())
         {
-            result += lit(string_t, ":");
-            result += cdv::to_string<string_t>(arrow.destination_port);
+            const bool is_hole =
+                member == layout.members.end() || (hole != holes.end() && hole->offset < member->offset);
+            const size_t offset = is_hole ? hole->offset : member->offset;
+            const size_t size = is_hole ? hole->size : member->size;
+            const size_t first_line = offset / line_bytes;
+            const size_t last_line = (offset + std::max<size_t>(size, 1) - 1) / line_bytes;
+            const std::string lines = first_line == last_line
+                                          ? std::to_string(first_line)
+                                          : std::to_string(first_line) + '-' + std::to_string(last_line);
+            report << std::setw(8) << offset << std::setw(8) << size << std::setw(8) << lines << "  "
+                   << (is_hole ? std::string_view{"<hole>"} : std::string_view{member->name}) << '\n';
+            if (is_hole)
+            {
+                ++hole;
+            }
+            else
+            {
+                ++member;
+            }
         }
 
-        // Arrow shape / style.
-        result += lit(string_t, "[");
-        if (arrow.shape != arrow_shape::normal)
-        {
-            result += lit(string_t, "shape");
-            result += lit(string_t, "=");
-            result += cdv::get_arrow_shape_name<string_t>(arrow.shape);
-            result += lit(string_t, ","); // Trailing commas are allowed in the graphviz grammar.
-        }
-        if (arrow.style != edge_style::normal)
+        if (!layout.unlocated_member_names.empty())
         {
-            result += lit(string_t, "style");
-            result += lit(string_t, "=");
-            result += cdv::get_edge_style_name<string_t>(arrow.style);
-            result += lit(string_t, ","); // Trailing commas are allowed in the graphviz grammar.
+            report << "  Not located:";
+            for (const std::string &member_name : layout.unlocated_member_names)
+            {
+                report << ' ' << member_name;
+            }
+            report << '\n';
         }
-        result += lit(string_t, "]\n");
+        report << "  Holes: " << layout.get_hole_bytes() << " bytes per instance, " << usage.get_total_hole_bytes()
+               << " bytes in total\n\n";
     }
+    return report.str();
+}
 
-    // 4. TODO: print each undirected edge.
-
-    // 5. Rank constraints.
-    for (const rank_constraint &constraint : visualization.m_rank_constraints)
+inline std::string generate_reference_cycle_report_string(const std::vector<reference_cycle> &cycles)
+{
+    std::ostringstream report;
+    size_t rank = 0;
+    for (const reference_cycle &cycle : cycles)
     {
-        if (!constraint.constrained_node_ids.empty())
+        report << "Cycle " << ++rank << ": " << cycle.node_ids.size() << " objects, " << cycle.cycle_bytes
+               << " bytes, retaining " << cycle.retained_bytes << " bytes\n";
+
+        // Number of objects per type, in order of first appearance.
+        std::vector<std::pair<std::string_view, size_t>> type_counts;
+        for (const std::string_view type_name : cycle.type_names)
         {
-            result += lit(string_t, "{rank=same;");
-            for (const auto node_id : constraint.constrained_node_ids)
+            const auto type_count = std::find_if(type_counts.begin(), type_counts.end(),
+                                                 [type_name](const auto &count) { return count.first == type_name; });
+            if (type_count != type_counts.end())
             {
-                result += cdv::to_string<string_t>(node_id);
-                result += lit(string_t, ";");
+                ++type_count->second;
             }
-            result += lit(string_t, "}");
+            else
+            {
+                type_counts.emplace_back(type_name, 1);
+            }
+        }
+        for (const auto &[type_name, count] : type_counts)
+        {
+            report << std::setw(10) << count << "  " << type_name << '\n';
         }
     }
-
-    // 6. Close the graph !
-    result += lit(string_t, "}\n");
-
-    return result;
+    return report.str();
 }
 
 #undef lit
 
 } // namespace cdv
 
+/**
+ * Explicit instantiations of everything that only depends on the string type: nodes, node storage, escaping and DOT
+ * serialization. Only the traversal of user types (visualization::add_data_structure and what it calls) depends on
+ * other types. Prefix is either 'template' (instantiation) or 'extern template' (declaration).
+ */
+#define CDV_IMPL_STRING_INSTANTIATIONS(Prefix, StringType)                                                             \
+    Prefix class base_node<StringType>;                                                                                \
+    Prefix class table<StringType>;                                                                                    \
+    Prefix class table_node<StringType>;                                                                               \
+    Prefix class adapted_class_node<StringType>;                                                                       \
+    Prefix struct arrow<StringType>;                                                                                   \
+    Prefix class impl::node_id_writer<StringType>;                                                                     \
+    Prefix class visualization<StringType>;                                                                            \
+    Prefix void impl::replace_all<StringType>(StringType &, const StringType &, const StringType &);                   \
+    Prefix void impl::make_html_compatible<StringType>(StringType &);                                                  \
+    Prefix StringType impl::make_dot_quoted_string<StringType>(StringType);                                            \
+    Prefix void impl::make_bold<StringType>(StringType &);                                                             \
+    Prefix void impl::remove_class_struct<StringType>(StringType &);                                                   \
+    Prefix StringType impl::generate_table_node_cell_html<StringType>(const table_node<StringType>::cell &);           \
+    Prefix StringType impl::generate_table_node_cell_opening_html<StringType>(const table_node<StringType>::cell &);   \
+    Prefix StringType impl::generate_node_appearance_string<StringType>(const node_appearance<StringType> &,           \
+                                                                        const node_appearance<StringType> &);          \
+    Prefix impl::adapted_class_skeleton<StringType> impl::make_adapted_class_skeleton<StringType>(                     \
+        const StringType &, const std::vector<StringType> &);                                                          \
+    Prefix void impl::append_unsigned_integer<StringType>(StringType &, uint64_t, const uint64_t);                     \
+    Prefix StringType impl::generate_cluster_style_string<StringType>(const cluster<StringType>);                      \
+    Prefix StringType impl::generate_cluster_color_string<StringType>(const cluster<StringType>);                      \
+    Prefix StringType impl::generate_cluster_label_string<StringType>(const cluster<StringType>);                      \
+    Prefix StringType impl::generate_default_node_appearance_string<StringType>(const cluster<StringType>);            \
+    Prefix void impl::append_graph_header_dot_string<StringType>(StringType &, const cluster<StringType> &);           \
+    Prefix void impl::append_node_dot_string<StringType>(StringType &, uint64_t, const base_node<StringType> &,        \
+                                                         const node_appearance<StringType> &,                          \
+                                                         impl::node_id_writer<StringType> &);                          \
+    Prefix void impl::append_arrow_dot_string<StringType>(StringType &, const arrow<StringType> &,                     \
+                                                          impl::node_id_writer<StringType> &);                         \
+    Prefix void impl::append_graph_footer_dot_string<StringType>(StringType &, const std::vector<rank_constraint> &,   \
+                                                                 impl::node_id_writer<StringType> &);                  \
+    Prefix StringType generate_dot_visualization_string<StringType>(const visualization<StringType> &,                 \
+                                                                    const dot_export_options &);                       \
+    Prefix StringType generate_svg_visualization_string<StringType>(const visualization<StringType> &,                 \
+                                                                    const svg_export_options &);
+
+#ifdef CDV_COMPILED_LIBRARY
+// Linking against the compiled cdv library (see src/): the string-only machinery is not instantiated again in
+// every translation unit.
+namespace cdv
+{
+CDV_IMPL_STRING_INSTANTIATIONS(extern template, std::string)
+CDV_IMPL_STRING_INSTANTIATIONS(extern template, std::wstring)
+} // namespace cdv
+#endif
+
 #define CDV_DECLARE_MEMBER(ClassName, MemberIndex, MemberNameRetrievalExpression, MemberValueGetterExpression)         \
     namespace cdv::traits                                                                                              \
     {                                                                                                                  \
@@ -1937,6 +7738,129 @@ template <typename string_t>
     };                                                                                                                 \
     }
 
+// Preprocessor utilities applying a macro to each argument of a variadic macro, with a fixed first argument.
+// Supports up to 64 arguments. CDV_IMPL_EXPAND makes MSVC's traditional preprocessor split __VA_ARGS__.
+#define CDV_IMPL_EXPAND(x) x
+#define CDV_IMPL_CONCAT(a, b) CDV_IMPL_CONCAT_IMPL(a, b)
+#define CDV_IMPL_CONCAT_IMPL(a, b) a##b
+#define CDV_IMPL_COUNT_ARGS(...) CDV_IMPL_EXPAND(CDV_IMPL_COUNT_ARGS_IMPL(__VA_ARGS__, 64, 63, 62, 61, 60, 59, 58,     \
+    57, 56, 55, 54, 53, 52, 51, 50, 49, 48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31,        \
+    30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+#define CDV_IMPL_COUNT_ARGS_IMPL(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18,      \
+    _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40,      \
+    _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62,      \
+    _63, _64, N, ...) N
+#define CDV_IMPL_FOR_EACH(M, F, ...)                                                                                   \
+    CDV_IMPL_EXPAND(CDV_IMPL_CONCAT(CDV_IMPL_FOR_EACH_, CDV_IMPL_COUNT_ARGS(__VA_ARGS__))(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_1(M, F, x) M(F, x)
+#define CDV_IMPL_FOR_EACH_2(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_1(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_3(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_2(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_4(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_3(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_5(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_4(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_6(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_5(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_7(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_6(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_8(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_7(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_9(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_8(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_10(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_9(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_11(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_10(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_12(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_11(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_13(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_12(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_14(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_13(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_15(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_14(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_16(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_15(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_17(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_16(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_18(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_17(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_19(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_18(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_20(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_19(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_21(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_20(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_22(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_21(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_23(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_22(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_24(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_23(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_25(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_24(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_26(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_25(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_27(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_26(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_28(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_27(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_29(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_28(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_30(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_29(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_31(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_30(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_32(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_31(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_33(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_32(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_34(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_33(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_35(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_34(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_36(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_35(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_37(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_36(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_38(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_37(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_39(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_38(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_40(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_39(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_41(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_40(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_42(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_41(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_43(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_42(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_44(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_43(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_45(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_44(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_46(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_45(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_47(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_46(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_48(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_47(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_49(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_48(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_50(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_49(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_51(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_50(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_52(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_51(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_53(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_52(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_54(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_53(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_55(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_54(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_56(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_55(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_57(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_56(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_58(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_57(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_59(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_58(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_60(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_59(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_61(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_60(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_62(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_61(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_63(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_62(M, F, __VA_ARGS__))
+#define CDV_IMPL_FOR_EACH_64(M, F, x, ...) M(F, x), CDV_IMPL_EXPAND(CDV_IMPL_FOR_EACH_63(M, F, __VA_ARGS__))
+
+/**
+ * Adapts a class by declaring all its displayed public data members at once, in display order:
+ *   CDV_ADAPT_CLASS(Position, x, y, z)
+ * Generates a single traits::members specialization holding a constexpr table of member descriptors, instead of one
+ * traits::access specialization per member. Members must not be references or bit-fields.
+ */
+#define CDV_ADAPT_CLASS(ClassName, ...)                                                                                \
+    namespace cdv::traits                                                                                              \
+    {                                                                                                                  \
+    template <>                                                                                                        \
+    struct members<ClassName> : std::true_type                                                                         \
+    {                                                                                                                  \
+        static constexpr auto get()                                                                                    \
+        {                                                                                                              \
+            return cdv::traits::make_member_table(                                                                     \
+                CDV_IMPL_FOR_EACH(CDV_IMPL_MEMBER_DESCRIPTOR, ClassName, __VA_ARGS__));                                \
+        }                                                                                                              \
+    };                                                                                                                 \
+    }
+
+#define CDV_IMPL_MEMBER_DESCRIPTOR(ClassName, MemberName)                                                              \
+    cdv::traits::make_member_descriptor(#MemberName, &ClassName::MemberName)
+
+/**
+ * Adapts a struct-of-arrays class by declaring its columns: public data members that are linear containers of the
+ * same length, in display order:
+ *   CDV_ADAPT_COLUMNS(Particles, x, y, mass)
+ * The class is displayed as one table with a row per index. See visualization::add_columns_slice to display some of
+ * the rows and columns only.
+ */
+#define CDV_ADAPT_COLUMNS(ClassName, ...)                                                                              \
+    namespace cdv::traits                                                                                              \
+    {                                                                                                                  \
+    template <>                                                                                                        \
+    struct columns<ClassName> : std::true_type                                                                         \
+    {                                                                                                                  \
+        static constexpr auto get()                                                                                    \
+        {                                                                                                              \
+            return cdv::traits::make_member_table(                                                                     \
+                CDV_IMPL_FOR_EACH(CDV_IMPL_MEMBER_DESCRIPTOR, ClassName, __VA_ARGS__));                                \
+        }                                                                                                              \
+    };                                                                                                                 \
+    }
+
 // TODO : DECLARE_CUSTOM_MEMBER pour déclarer un membre sur lequel on n'appelle pas un getter mais une méthode perso
 // prenant l'instance en paramètre directement.
 
@@ -0,0 +1,11 @@
+// Compiled part of the cdv library: explicit instantiations of the machinery that only depends on the string type.
+// Translation units including cdv.hpp with CDV_COMPILED_LIBRARY defined (set when linking against the cdv target)
+// use these instead of instantiating their own copies. std::wstring has its own file, so that programs only using
+// std::string do not link it.
+
+#include "cdv/cdv.hpp"
+
+namespace cdv
+{
+CDV_IMPL_STRING_INSTANTIATIONS(template, std::string)
+} // namespace cdv
@@ -0,0 +1,8 @@
+// Compiled part of the cdv library for std::wstring, see cdv.cpp.
+
+#include "cdv/cdv.hpp"
+
+namespace cdv
+{
+CDV_IMPL_STRING_INSTANTIATIONS(template, std::wstring)
+} // namespace cdv
@@ -66,6 +66,15 @@ CDV_DECLARE_PUBLIC_MEMBER(TreeNode, 0, name)
 CDV_DECLARE_PUBLIC_MEMBER(TreeNode, 1, left)
 CDV_DECLARE_PUBLIC_MEMBER(TreeNode, 2, right)
 
+struct Particle
+{
+    std::string name;
+    Position position;
+    double mass{1.0};
+    std::vector<int> neighbours;
+};
+CDV_ADAPT_CLASS(Particle, name, position, mass, neighbours)
+
 
 void example_1()
 {
@@ -199,6 +208,498 @@ void example_6_user_defined_tree()
     std::cout << cdv::generate_dot_visualization_string(visualization) << "\n";
 }
 
+void example_7_parallel_traversal()
+{
+    cdv::visualization<std::string> visualization;
+    // Use all the cores, with tasks of 256 elements.
+    visualization.set_parallel_traversal(0, 256);
+
+    std::vector<Position> positions;
+    positions.reserve(4096);
+    for (int i = 0; i < 4096; ++i)
+    {
+        positions.emplace_back(Position{i, i % 7, i % 3});
+    }
+    visualization.add_data_structure(positions);
+
+    std::vector<Position *> position_pointers;
+    position_pointers.reserve(positions.size());
+    for (Position &position : positions)
+    {
+        position_pointers.emplace_back(&position);
+    }
+    visualization.add_data_structure(position_pointers);
+
+    std::cout << cdv::generate_dot_visualization_string(visualization) << "\n";
+}
+void example_8_budgeted_capture()
+{
+    cdv::visualization<std::string> visualization;
+
+    TreeNode root{"root"};
+    root.left = std::make_unique<TreeNode>("a");
+    root.right = std::make_unique<TreeNode>("b");
+    root.left->left = std::make_unique<TreeNode>("c");
+    root.right->right = std::make_unique<TreeNode>("d");
+
+    // The tree is not modified during the capture, so its version never changes.
+    const uint64_t tree_version = 0;
+    visualization.begin_capture(root, [&tree_version] { return tree_version; });
+    while (visualization.step(std::chrono::milliseconds(2)) == cdv::capture_status::in_progress)
+    {
+        // Other work of the event loop.
+    }
+
+    std::cout << cdv::generate_dot_visualization_string(visualization) << "\n";
+}
+void example_9_streaming()
+{
+    cdv::visualization<std::string> visualization;
+
+    std::vector<Position> positions(100);
+    // Nodes and edges are written to std::cout while the data is traversed, and are not kept in memory.
+    visualization.begin_streaming(std::cout);
+    visualization.add_data_structure(positions);
+    visualization.end_streaming();
+}
+
+void example_10_adapted_class()
+{
+    cdv::visualization<std::string> visualization;
+
+    const std::vector<Particle> particles{{"proton", {0, 1, 2}, 938.3, {1}}, {"neutron", {3, 4, 5}, 939.6, {0}}};
+    visualization.add_data_structure(particles);
+
+    std::cout << cdv::generate_dot_visualization_string(visualization) << "\n";
+}
+
+void example_11_memory_report()
+{
+    cdv::visualization<std::string> visualization;
+
+    std::vector<Particle> particles(3);
+    for (Particle &particle : particles)
+    {
+        particle.name = "A name too long to be stored inside the string itself";
+        particle.neighbours.reserve(16);
+    }
+    visualization.add_data_structure(particles);
+
+    std::cout << cdv::generate_memory_report_string(visualization.get_memory_usage_by_type()) << "\n";
+}
+
+void example_12_retained_size()
+{
+    cdv::visualization<std::string> visualization;
+
+    std::vector<Particle> particles(3);
+    particles[0].neighbours.resize(1000);
+    visualization.add_data_structure(particles);
+
+    const cdv::dominator_tree dominator_tree = visualization.compute_dominator_tree();
+    for (const cdv::retainer &retainer : dominator_tree.get_top_retainers(3))
+    {
+        std::cout << retainer.type_name << " " << retainer.node_id << ": " << retainer.retained_bytes << "\n";
+    }
+}
+
+void example_13_capacity_report()
+{
+    cdv::visualization<std::string> visualization;
+    // Highlight the vectors wasting at least 256 bytes.
+    visualization.set_capacity_reporting(true, 256);
+
+    std::vector<Position> positions(3);
+    positions.reserve(100);
+    visualization.add_data_structure(positions);
+
+    const std::list<std::string> names{"short", "A name too long to be stored inside the string itself"};
+    visualization.add_data_structure(names);
+
+    std::cout << cdv::generate_dot_visualization_string(visualization) << "\n";
+}
+
+// Only 8 different hashes: whatever the bucket count, keys with the same remainder share a bucket.
+struct PoorHash
+{
+    size_t operator()(const int key) const
+    {
+        return static_cast<size_t>(key % 8);
+    }
+};
+
+void example_14_hash_table()
+{
+    cdv::visualization<std::string> visualization;
+
+    std::unordered_map<int, std::string, PoorHash> names_by_id;
+    for (int id = 0; id < 100; ++id)
+    {
+        names_by_id[id] = "name " + std::to_string(id);
+    }
+    // The 100 names fill 8 buckets: the longest chain holds 13 keys, and the other buckets are empty.
+    visualization.set_hash_table_health(true);
+    visualization.add_data_structure(names_by_id);
+
+    std::cout << cdv::generate_dot_visualization_string(visualization) << "\n";
+}
+
+struct Reading
+{
+    bool is_valid{true};
+    double value{0.0};
+    char unit{'m'};
+    int64_t timestamp{0};
+};
+CDV_ADAPT_CLASS(Reading, is_valid, value, unit, timestamp)
+
+void example_15_class_layout()
+{
+    cdv::visualization<std::string> visualization;
+
+    // Reordering the members by decreasing size would shrink each reading from 32 to 24 bytes.
+    const std::vector<Reading> readings(1000);
+    visualization.add_data_structure(readings);
+
+    std::cout << cdv::generate_class_layout_report_string(visualization.get_class_layouts()) << "\n";
+}
+
+void example_16_locality()
+{
+    cdv::visualization<std::string> visualization;
+
+    // Nodes allocated one after the other are usually close to each other.
+    std::list<int> values;
+    for (int value = 0; value < 1000; ++value)
+    {
+        values.push_back(value);
+    }
+    visualization.add_data_structure(values);
+
+    // Each child is allocated after a big buffer, far from its parent.
+    std::vector<std::unique_ptr<char[]>> buffers;
+    buffers.reserve(100);
+    TreeNode root{"root"};
+    TreeNode *node = &root;
+    for (int depth = 0; depth < 100; ++depth)
+    {
+        buffers.emplace_back(new char[8192]);
+        node->left = std::make_unique<TreeNode>("child");
+        node = node->left.get();
+    }
+    visualization.add_data_structure(root);
+
+    std::cout << cdv::generate_locality_report_string(visualization.get_locality_by_type()) << "\n";
+}
+
+void example_17_memory_regions()
+{
+    cdv::visualization<std::string> visualization;
+
+    // Two positions updated by different threads, allocated next to each other in the same cache line.
+    alignas(64) static unsigned char pool[1024];
+    const auto *first_position = new (pool) Position{};
+    const auto *second_position = new (pool + sizeof(Position)) Position{};
+    visualization.add_memory_arena(pool, sizeof(pool), "pool");
+    visualization.add_data_structure(*first_position);
+    visualization.add_data_structure(*second_position);
+
+    const std::vector<Position> positions(3);
+    visualization.add_data_structure(positions);
+
+    cdv::dot_export_options options;
+    options.memory_regions = cdv::memory_region_grouping::arena;
+    options.highlight_false_sharing = true;
+    std::cout << cdv::generate_dot_visualization_string(visualization, options) << "\n";
+}
+
+struct Person
+{
+    explicit Person(std::string _name)
+        : name{std::move(_name)}
+    {
+    }
+    std::string name;
+    std::vector<std::shared_ptr<Person>> friends;
+    std::weak_ptr<Person> manager;
+};
+CDV_ADAPT_CLASS(Person, name, friends, manager)
+
+void example_18_reference_cycles()
+{
+    cdv::visualization<std::string> visualization;
+
+    // Alice and Bob own each other: they are never destroyed. Weak pointers do not keep their object alive.
+    auto alice = std::make_shared<Person>("Alice");
+    auto bob = std::make_shared<Person>("Bob");
+    auto carol = std::make_shared<Person>("Carol");
+    alice->friends.push_back(bob);
+    bob->friends.push_back(alice);
+    carol->manager = alice;
+    visualization.add_data_structure(carol);
+    visualization.add_data_structure(alice);
+
+    std::cout << cdv::generate_reference_cycle_report_string(visualization.find_reference_cycles()) << "\n";
+    std::cout << cdv::generate_dot_visualization_string(visualization) << "\n";
+}
+
+struct ListNode
+{
+    int value{0};
+    ListNode *previous{nullptr};
+    ListNode *next{nullptr};
+};
+CDV_ADAPT_CLASS(ListNode, value, previous, next)
+
+void example_19_summarized_export()
+{
+    cdv::visualization<std::string> visualization;
+
+    // A doubly-linked list is a single strongly connected component.
+    std::vector<ListNode> list_nodes(1000);
+    for (size_t index = 0; index + 1 < list_nodes.size(); ++index)
+    {
+        list_nodes[index].next = &list_nodes[index + 1];
+        list_nodes[index + 1].previous = &list_nodes[index];
+    }
+    visualization.add_data_structure(list_nodes.front());
+
+    // A singly-linked list is a chain.
+    std::vector<ListNode> forward_list_nodes(1000);
+    for (size_t index = 0; index + 1 < forward_list_nodes.size(); ++index)
+    {
+        forward_list_nodes[index].next = &forward_list_nodes[index + 1];
+    }
+    visualization.add_data_structure(forward_list_nodes.front());
+
+    cdv::dot_export_options options;
+    options.collapsed_component_min_size = 10;
+    options.folded_chain_min_length = 10;
+    std::cout << cdv::generate_dot_visualization_string(visualization, options) << "\n";
+}
+
+void example_20_identical_subgraphs()
+{
+    cdv::visualization<std::string> visualization;
+
+    // Only the moved particle differs from the others.
+    std::vector<Particle> particles(1000);
+    for (Particle &particle : particles)
+    {
+        particle.neighbours = {1, 2, 3};
+    }
+    particles[10].position.x = 5;
+    visualization.add_data_structure(particles);
+
+    cdv::dot_export_options options;
+    options.merge_identical_subgraphs = true;
+    std::cout << cdv::generate_dot_visualization_string(visualization, options) << "\n";
+}
+
+void example_21_numeric_summary()
+{
+    cdv::visualization<std::string> visualization;
+    visualization.set_numeric_summary(1000, 8);
+
+    std::vector<double> samples(1000000);
+    for (size_t index = 0; index < samples.size(); ++index)
+    {
+        samples[index] = static_cast<double>(index % 1000) / 10.0;
+    }
+    samples[42] = std::numeric_limits<double>::quiet_NaN();
+    visualization.add_data_structure(samples);
+
+    std::cout << cdv::generate_dot_visualization_string(visualization) << "\n";
+}
+
+void example_22_matrix_display()
+{
+    cdv::visualization<std::string> visualization;
+    visualization.set_matrix_display(16, cdv::matrix_pooling::max);
+
+    // A 500 x 300 grid, drawn as 16 x 16 blocks, with one jagged row.
+    std::vector<std::vector<float>> grid(500, std::vector<float>(300));
+    for (size_t row = 0; row < grid.size(); ++row)
+    {
+        for (size_t column = 0; column < grid[row].size(); ++column)
+        {
+            grid[row][column] = static_cast<float>(row * column);
+        }
+    }
+    grid[250].resize(100);
+    visualization.add_data_structure(grid);
+
+    std::cout << cdv::generate_dot_visualization_string(visualization) << "\n";
+}
+
+struct Message
+{
+    std::string_view topic;
+    cdv::array_view<const uint8_t> payload;
+};
+CDV_ADAPT_CLASS(Message, topic, payload)
+
+void example_23_views()
+{
+    cdv::visualization<std::string> visualization;
+
+    // The message only views parts of the buffer, which is displayed without being copied.
+    const std::string topic = "sensors/temperature";
+    const uint8_t buffer[] = {0x01, 0x02, 0x10, 0x20, 0x30, 0x40};
+    const Message message{std::string_view{topic}.substr(0, 7), cdv::make_array_view(buffer + 2, 4)};
+    visualization.add_data_structure(message);
+    visualization.add_data_structure(cdv::make_array_view(buffer, std::size(buffer)));
+
+    std::cout << cdv::generate_dot_visualization_string(visualization) << "\n";
+}
+
+void example_24_memory_resources()
+{
+    cdv::visualization<std::string> visualization;
+
+    // Containers allocated in the frame arena show its name.
+    std::pmr::monotonic_buffer_resource frame_arena;
+    visualization.name_memory_resource(&frame_arena, "frame arena");
+
+    std::pmr::vector<int> ids{{1, 2, 3}, &frame_arena};
+    std::pmr::list<Position> positions{{Position{}, Position{}}, &frame_arena};
+    visualization.add_data_structure(ids);
+    visualization.add_data_structure(positions);
+
+    std::cout << cdv::generate_dot_visualization_string(visualization) << "\n";
+}
+
+void example_25_key_value_containers()
+{
+    cdv::visualization<std::string> visualization;
+
+    // Keys and values are displayed like the elements of linear containers: numbers inside, pointers and adapted
+    // classes as edges.
+    std::map<int, Position> positions_by_id;
+    std::unordered_map<std::string, double> prices_by_name{{"apple", 1.5}, {"pear", 2.25}};
+    for (int id = 0; id < 1000; ++id)
+    {
+        positions_by_id[id] = Position{id, 2 * id, 3 * id};
+    }
+    visualization.set_key_value_elision(20);
+    visualization.add_data_structure(prices_by_name);
+
+    // Only the elements from 500 to 504 are visited.
+    visualization.add_map_slice(positions_by_id, 500, 504);
+
+    std::cout << cdv::generate_dot_visualization_string(visualization) << "\n";
+}
+
+struct ParticleColumns
+{
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<double> mass;
+    std::vector<std::string> name;
+};
+CDV_ADAPT_COLUMNS(ParticleColumns, x, y, mass, name)
+
+void example_26_struct_of_arrays()
+{
+    cdv::visualization<std::string> visualization;
+
+    ParticleColumns particles;
+    for (int index = 0; index < 1000; ++index)
+    {
+        particles.x.push_back(static_cast<float>(index));
+        particles.y.push_back(static_cast<float>(index) * 0.5f);
+        particles.mass.push_back(1.0 + index % 3);
+        particles.name.push_back("p" + std::to_string(index));
+    }
+
+    // Rows 10 to 15 of the positions only.
+    visualization.add_columns_slice(particles, 10, 16, {"x", "y"});
+
+    std::cout << cdv::generate_dot_visualization_string(visualization) << "\n";
+}
+
+void example_27_svg_layout()
+{
+    cdv::visualization<std::string> visualization;
+
+    NodeGraph a{"a"};
+    NodeGraph b{"b"};
+    NodeGraph c{"c"};
+    a.nodes = {&b, &c};
+    b.nodes = {&c};
+    c.nodes = {&a}; // Cycle, drawn going up.
+    visualization.add_data_structure(a);
+
+    std::cout << cdv::generate_svg_visualization_string(visualization) << "\n";
+}
+
+struct Leaf
+{
+    int value{0};
+};
+CDV_ADAPT_CLASS(Leaf, value)
+
+struct Inner
+{
+    Leaf *leaf{nullptr};
+    int count{0};
+};
+CDV_ADAPT_CLASS(Inner, leaf, count)
+
+// Its first member has the same address, hence the same node ID.
+struct Outer
+{
+    Inner inner;
+    int count{0};
+};
+CDV_ADAPT_CLASS(Outer, inner, count)
+
+// Lines of a DOT string, sorted: a budgeted capture traverses the nodes in another order.
+std::vector<std::string> get_sorted_lines(const std::string &dot_string)
+{
+    std::vector<std::string> lines;
+    std::istringstream stream{dot_string};
+    for (std::string line; std::getline(stream, line);)
+    {
+        lines.push_back(line);
+    }
+    std::sort(lines.begin(), lines.end());
+    return lines;
+}
+
+void example_28_capture_of_first_members()
+{
+    Leaf leaf{7};
+    Outer outer{{&leaf, 1}, 2};
+
+    cdv::visualization<std::string> traversal;
+    traversal.add_data_structure(outer);
+
+    // The smallest budget: one node per step.
+    cdv::visualization<std::string> capture;
+    capture.begin_capture(outer);
+    while (capture.step(std::chrono::nanoseconds(1)) == cdv::capture_status::in_progress)
+    {
+    }
+
+    const std::string capture_dot_string = cdv::generate_dot_visualization_string(capture);
+    const bool is_same_graph =
+        get_sorted_lines(capture_dot_string) == get_sorted_lines(cdv::generate_dot_visualization_string(traversal));
+    std::cout << capture_dot_string << "\n" << (is_same_graph ? "Same graph" : "Different graph") << "\n";
+}
+
+void example_29_views_of_a_container()
+{
+    cdv::visualization<std::string> visualization;
+
+    // The array and its two views start at the same address, but are three different nodes.
+    const std::array<int, 4> values{1, 2, 3, 4};
+    visualization.add_data_structure(values);
+    visualization.add_data_structure(cdv::make_array_view(values.data(), 2));
+    visualization.add_data_structure(cdv::make_array_view(values.data(), 3));
+
+    std::cout << cdv::generate_dot_visualization_string(visualization) << "\n";
+}
 
 void big_example()
 {
@@ -301,5 +802,28 @@ int main()
     // example_4_user_defined_graph();
     // example_5_nullptr();
     example_6_user_defined_tree();
+    // example_7_parallel_traversal();
+    // example_8_budgeted_capture();
+    // example_9_streaming();
+    // example_10_adapted_class();
+    // example_11_memory_report();
+    // example_12_retained_size();
+    // example_13_capacity_report();
+    // example_14_hash_table();
+    // example_15_class_layout();
+    // example_16_locality();
+    // example_17_memory_regions();
+    // example_18_reference_cycles();
+    // example_19_summarized_export();
+    // example_20_identical_subgraphs();
+    // example_21_numeric_summary();
+    // example_22_matrix_display();
+    // example_23_views();
+    // example_24_memory_resources();
+    // example_25_key_value_containers();
+    // example_26_struct_of_arrays();
+    // example_27_svg_layout();
+    // example_28_capture_of_first_members();
+    // example_29_views_of_a_container();
     return 0;
 }